@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ondrart/base64/codec.h>
+
+#include <assert.h>
+#include <algorithm>
+
+#include <ondrart/base64/base64error.h>
+
+#include "kernel.h"
+
+namespace OndraRT {
+
+namespace Base64 {
+
+namespace {
+
+bool isSpace(
+    char c_) noexcept {
+  switch(c_) {
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\v':
+    case '\f':
+    case '\r':
+      return true;
+    default:
+      return false;
+  }
+}
+
+} /* -- namespace */
+
+template<typename Alphabet_>
+BasicEncoder<Alphabet_>::BasicEncoder(
+    int line_length_) noexcept :
+  len_quat((line_length_ <= 3)?-1:(line_length_ / 4)),
+  quaternions(0) {
+
+}
+
+template<typename Alphabet_>
+std::size_t BasicEncoder<Alphabet_>::getLength(
+    std::size_t length_) const noexcept {
+  const std::size_t quats_((length_ + 2) / 3);
+  std::size_t encoded_;
+  if(Alphabet_::padding() || length_ % 3 == 0)
+    encoded_ = quats_ * 4;
+  else
+    encoded_ = length_ / 3 * 4 + length_ % 3 + 1;
+  if(len_quat > 0) {
+    const std::size_t breaks_((quaternions + quats_) / len_quat);
+    encoded_ += breaks_ * (Alphabet_::crlf() ? 2 : 1);
+  }
+  return encoded_;
+}
+
+template<typename Alphabet_>
+void BasicEncoder<Alphabet_>::breakLine(
+    char*& output_) {
+  quaternions = 0;
+  if(Alphabet_::crlf())
+    *output_++ = '\r';
+  *output_++ = '\n';
+}
+
+template<typename Alphabet_>
+std::size_t BasicEncoder<Alphabet_>::encode(
+    const void* input_,
+    std::size_t length_,
+    char* output_,
+    std::size_t capacity_) {
+  if(capacity_ < getLength(length_))
+    throw Base64Error("base64 output buffer is too small");
+
+  const std::uint8_t* in_(static_cast<const std::uint8_t*>(input_));
+  char* out_(output_);
+
+  /* -- whole triplets, the lines are broken if it's needed */
+  std::size_t triplets_(length_ / 3);
+  if(len_quat > 0) {
+    while(triplets_ > 0) {
+      std::size_t line_(len_quat - quaternions);
+      if(line_ > triplets_)
+        line_ = triplets_;
+      Kernel::encodeTriplets<Alphabet_::char62(), Alphabet_::char63()>(
+          in_, line_, out_);
+      in_ += 3 * line_;
+      out_ += 4 * line_;
+      triplets_ -= line_;
+
+      quaternions += static_cast<int>(line_);
+      if(quaternions >= len_quat)
+        breakLine(out_);
+    }
+  }
+  else {
+    Kernel::encodeTriplets<Alphabet_::char62(), Alphabet_::char63()>(
+        in_, triplets_, out_);
+    in_ += 3 * triplets_;
+    out_ += 4 * triplets_;
+  }
+
+  /* -- the last incomplete triplet with padding */
+  const std::size_t rest_(length_ % 3);
+  if(rest_ > 0) {
+    Kernel::encodeTail<Alphabet_::char62(), Alphabet_::char63()>(
+        in_, rest_, out_);
+    out_ += rest_ + 1;
+    if(Alphabet_::padding()) {
+      for(std::size_t i_(rest_); i_ < 3; ++i_)
+        *out_++ = '=';
+    }
+    if(len_quat > 0) {
+      ++quaternions;
+      if(quaternions >= len_quat)
+        breakLine(out_);
+    }
+  }
+
+  return out_ - output_;
+}
+
+template<typename Alphabet_>
+void BasicEncoder<Alphabet_>::advance(
+    std::size_t length_) noexcept {
+  assert(length_ % 3 == 0);
+
+  if(len_quat > 0)
+    quaternions = static_cast<int>(
+        (quaternions + length_ / 3) % static_cast<std::size_t>(len_quat));
+}
+
+template<typename Alphabet_>
+BasicDecoder<Alphabet_>::BasicDecoder() noexcept :
+  pending_count(0),
+  padding(0),
+  terminated(false) {
+
+}
+
+template<typename Alphabet_>
+std::uint8_t* BasicDecoder<Alphabet_>::decodeChar(
+    char c_,
+    std::uint8_t* output_,
+    std::uint8_t* end_) {
+  if(isSpace(c_))
+    return output_;
+  if(terminated)
+    throw Base64Error("unexpected data after the base64 padding");
+
+  /* -- the padding */
+  if(Alphabet_::padding() && c_ == '=') {
+    if(pending_count < 2)
+      throw Base64Error("unexpected base64 padding");
+    ++padding;
+    if(pending_count + padding == 4) {
+      pending_count = 0;
+      terminated = true;
+    }
+    return output_;
+  }
+  if(padding > 0)
+    throw Base64Error("invalid base64 padding");
+
+  /* -- a character of the alphabet, the bytes are written as soon as
+   *    all their bits are known */
+  const int value_(
+      Kernel::decodeChar<Alphabet_::char62(), Alphabet_::char63()>(c_));
+  if(value_ < 0)
+    throw Base64Error("invalid character in base64 data");
+  if(pending_count > 0 && output_ >= end_)
+    throw Base64Error("base64 output buffer is too small");
+  switch(pending_count) {
+    case 1:
+      *output_++ = (pending[0] << 2) | (value_ >> 4);
+      break;
+    case 2:
+      *output_++ = ((pending[1] & 0x0f) << 4) | (value_ >> 2);
+      break;
+    case 3:
+      *output_++ = ((pending[2] & 0x03) << 6) | value_;
+      break;
+  }
+  if(pending_count < 3)
+    pending[pending_count++] = static_cast<std::uint8_t>(value_);
+  else
+    pending_count = 0;
+  return output_;
+}
+
+template<typename Alphabet_>
+std::size_t BasicDecoder<Alphabet_>::decode(
+    const char* input_,
+    std::size_t length_,
+    void* output_,
+    std::size_t capacity_) {
+  const char* const in_end_(input_ + length_);
+  std::uint8_t* const out_begin_(static_cast<std::uint8_t*>(output_));
+  std::uint8_t* const out_end_(out_begin_ + capacity_);
+  std::uint8_t* out_(out_begin_);
+  while(input_ < in_end_) {
+    /* -- decode uninterrupted quaternions by the fast kernel */
+    if(pending_count == 0 && !terminated) {
+      const std::size_t quads_(std::min<std::size_t>(
+          (in_end_ - input_) / 4, (out_end_ - out_) / 3));
+      const std::size_t decoded_(
+          Kernel::decodeQuads<Alphabet_::char62(), Alphabet_::char63()>(
+              input_, quads_, out_));
+      input_ += 4 * decoded_;
+      out_ += 3 * decoded_;
+      if(input_ == in_end_)
+        break;
+    }
+
+    /* -- whitespaces, padding and broken quaternions */
+    out_ = decodeChar(*input_, out_, out_end_);
+    ++input_;
+  }
+  return out_ - out_begin_;
+}
+
+template<typename Alphabet_>
+void BasicDecoder<Alphabet_>::finish() {
+  /* -- without the padding the last quaternion may be incomplete
+   *    but it must contain at least one whole byte */
+  const bool truncated_(
+      Alphabet_::padding() ? (pending_count > 0) : (pending_count == 1));
+  pending_count = 0;
+  padding = 0;
+  terminated = false;
+  if(truncated_)
+    throw Base64Error("truncated base64 data");
+}
+
+template<typename Alphabet_>
+std::size_t encodedLength(
+    std::size_t length_,
+    int line_length_) noexcept {
+  return BasicEncoder<Alphabet_>(line_length_).getLength(length_);
+}
+
+template<typename Alphabet_>
+std::size_t encode(
+    const void* input_,
+    std::size_t length_,
+    char* output_,
+    std::size_t capacity_,
+    int line_length_) {
+  BasicEncoder<Alphabet_> encoder_(line_length_);
+  return encoder_.encode(input_, length_, output_, capacity_);
+}
+
+std::size_t maxDecodedLength(
+    std::size_t length_) noexcept {
+  return (length_ + 3) / 4 * 3;
+}
+
+std::size_t decodedLength(
+    const char* input_,
+    std::size_t length_) noexcept {
+  std::size_t significant_(0);
+  for(const char* end_(input_ + length_); input_ < end_; ++input_) {
+    if(*input_ != '=' && !isSpace(*input_))
+      ++significant_;
+  }
+  return significant_ / 4 * 3 + (significant_ % 4) * 3 / 4;
+}
+
+template<typename Alphabet_>
+std::size_t decode(
+    const char* input_,
+    std::size_t length_,
+    void* output_,
+    std::size_t capacity_) {
+  BasicDecoder<Alphabet_> decoder_;
+  const std::size_t decoded_(
+      decoder_.decode(input_, length_, output_, capacity_));
+  decoder_.finish();
+  return decoded_;
+}
+
+#define ONDRART_BASE64_CODEC(alphabet_) \
+  template class BasicEncoder<alphabet_>; \
+  template class BasicDecoder<alphabet_>; \
+  template std::size_t encodedLength<alphabet_>(std::size_t, int) noexcept; \
+  template std::size_t encode<alphabet_>( \
+      const void*, std::size_t, char*, std::size_t, int); \
+  template std::size_t decode<alphabet_>( \
+      const char*, std::size_t, void*, std::size_t);
+
+ONDRART_BASE64_CODEC(AlphabetStandard)
+ONDRART_BASE64_CODEC(AlphabetNoPadding<AlphabetStandard>)
+ONDRART_BASE64_CODEC(AlphabetUrl)
+ONDRART_BASE64_CODEC(AlphabetNoPadding<AlphabetUrl>)
+ONDRART_BASE64_CODEC(AlphabetMime)
+
+#undef ONDRART_BASE64_CODEC
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ondrart/base64/file.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ondrart/base64/base64error.h>
+#include <ondrart/base64/codec.h>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+namespace {
+
+[[noreturn]] void throwSystemError(
+    const char* operation_,
+    const std::string& path_) {
+  throw Base64Error(
+      std::string("base64 cannot ") + operation_ + " '" + path_ + "': "
+      + std::strerror(errno));
+}
+
+[[noreturn]] void throwNotRegular(
+    const std::string& path_) {
+  throw Base64Error(
+      "base64 cannot write into '" + path_ + "': not a regular file");
+}
+
+/**
+ * @brief Owner of an opened file descriptor
+ */
+class File {
+  private:
+    std::string path;
+    int fd;
+
+  public:
+    explicit File(
+        const std::string& path_,
+        int flags_) :
+      path(path_),
+      fd(::open(path_.c_str(), flags_ | O_CLOEXEC, 0666)) {
+      if(fd < 0)
+        throwSystemError("open", path);
+    }
+
+    /**
+     * @brief Open an output file
+     *
+     * The file is created if it doesn't exist. An existing file must be
+     * a regular one.
+     *
+     * @param path_ Path of the file
+     * @param created_ It's set to true if the file has been created
+     */
+    explicit File(
+        const std::string& path_,
+        bool& created_) :
+      path(path_),
+      fd(::open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0666)) {
+      created_ = (fd >= 0);
+      if(fd < 0 && errno == EEXIST) {
+        /* -- check before opening, the opening itself could have side
+         *    effects on a device */
+        struct stat stat_;
+        if(::stat(path.c_str(), &stat_) < 0)
+          throwSystemError("stat", path);
+        if(!S_ISREG(stat_.st_mode))
+          throwNotRegular(path);
+        fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+      }
+      if(fd < 0)
+        throwSystemError("open", path);
+
+      /* -- the file could be replaced after the check */
+      struct stat stat_;
+      if(::fstat(fd, &stat_) < 0 || !S_ISREG(stat_.st_mode)) {
+        ::close(fd);
+        throwNotRegular(path);
+      }
+    }
+
+    ~File() {
+      ::close(fd);
+    }
+
+    /* -- avoid copying */
+    File(
+        const File&) = delete;
+    File& operator =(
+        const File&) = delete;
+
+    struct stat getStat() const {
+      struct stat stat_;
+      if(::fstat(fd, &stat_) < 0)
+        throwSystemError("stat", path);
+      return stat_;
+    }
+
+    std::size_t getSize() const {
+      return getStat().st_size;
+    }
+
+    bool isSame(
+        const File& file_) const {
+      const struct stat this_(getStat());
+      const struct stat other_(file_.getStat());
+      return this_.st_dev == other_.st_dev && this_.st_ino == other_.st_ino;
+    }
+
+    void resize(
+        std::size_t size_) {
+      if(::ftruncate(fd, size_) < 0)
+        throwSystemError("resize", path);
+
+      /* -- Allocate the blocks in advance. A write into a mapped sparse
+       *    file would kill the process by SIGBUS if the disk is full. */
+      if(size_ > 0) {
+        const int error_(::posix_fallocate(fd, 0, size_));
+        if(error_ != 0 && error_ != EINVAL && error_ != EOPNOTSUPP) {
+          errno = error_;
+          throwSystemError("allocate", path);
+        }
+      }
+    }
+
+    int getFd() const noexcept {
+      return fd;
+    }
+
+    const std::string& getPath() const noexcept {
+      return path;
+    }
+};
+
+/**
+ * @brief Memory mapping of a whole file
+ *
+ * Empty files are not mapped, the mapping is a null pointer.
+ */
+class Mapping {
+  private:
+    void* data;
+    std::size_t size;
+
+  public:
+    explicit Mapping(
+        const File& file_,
+        std::size_t size_,
+        bool writable_) :
+      data(nullptr),
+      size(size_) {
+      if(size > 0) {
+        data = ::mmap(
+            nullptr,
+            size,
+            writable_ ? (PROT_READ | PROT_WRITE) : PROT_READ,
+            writable_ ? MAP_SHARED : MAP_PRIVATE,
+            file_.getFd(),
+            0);
+        if(data == MAP_FAILED)
+          throwSystemError("map", file_.getPath());
+        ::madvise(data, size, MADV_SEQUENTIAL);
+      }
+    }
+
+    ~Mapping() {
+      if(data != nullptr)
+        ::munmap(data, size);
+    }
+
+    /* -- avoid copying */
+    Mapping(
+        const Mapping&) = delete;
+    Mapping& operator =(
+        const Mapping&) = delete;
+
+    template<typename Type_>
+    Type_* getData() const noexcept {
+      return static_cast<Type_*>(data);
+    }
+};
+
+/**
+ * @brief Map the input file and convert it into the output file
+ *
+ * @param input_ Path of the input file
+ * @param output_ Path of the output file
+ * @param length_ Functor computing the exact output length from the input
+ * @param convert_ Functor converting the input into the output
+ */
+template<typename Length_, typename Convert_>
+std::size_t convertFile(
+    const std::string& input_,
+    const std::string& output_,
+    Length_ length_,
+    Convert_ convert_) {
+  File input_file_(input_, O_RDONLY);
+  const std::size_t input_size_(input_file_.getSize());
+  Mapping input_map_(input_file_, input_size_, false);
+
+  /* -- The output is not truncated until it's known not to be the input.
+   *    Otherwise the input would be destroyed under its own mapping. */
+  bool created_;
+  File output_file_(output_, created_);
+  if(output_file_.isSame(input_file_))
+    throw Base64Error(
+        "base64 cannot convert '" + input_ + "' into itself");
+
+  try {
+    const std::size_t output_size_(
+        length_(input_map_.getData<const char>(), input_size_));
+    output_file_.resize(output_size_);
+    Mapping output_map_(output_file_, output_size_, true);
+    convert_(
+        input_map_.getData<const char>(),
+        input_size_,
+        output_map_.getData<char>(),
+        output_size_);
+    return output_size_;
+  }
+  catch(...) {
+    /* -- only a file created by this call is removed */
+    if(created_)
+      ::unlink(output_.c_str());
+    throw;
+  }
+}
+
+} /* -- namespace */
+
+template<typename Alphabet_>
+std::size_t encodeFile(
+    const std::string& input_,
+    const std::string& output_,
+    int line_length_) {
+  BasicEncoder<Alphabet_> encoder_(line_length_);
+  return convertFile(
+      input_,
+      output_,
+      [&encoder_](const char*, std::size_t length_) {
+        return encoder_.getLength(length_);
+      },
+      [&encoder_](
+          const char* input_,
+          std::size_t length_,
+          char* output_,
+          std::size_t capacity_) {
+        encoder_.encode(input_, length_, output_, capacity_);
+      });
+}
+
+template<typename Alphabet_>
+std::size_t decodeFile(
+    const std::string& input_,
+    const std::string& output_) {
+  return convertFile(
+      input_,
+      output_,
+      [](const char* input_, std::size_t length_) {
+        return decodedLength(input_, length_);
+      },
+      [](
+          const char* input_,
+          std::size_t length_,
+          char* output_,
+          std::size_t capacity_) {
+        if(decode<Alphabet_>(input_, length_, output_, capacity_) != capacity_)
+          throw Base64Error("base64 decoded data are truncated");
+      });
+}
+
+#define ONDRART_BASE64_FILE(alphabet_) \
+  template std::size_t encodeFile<alphabet_>( \
+      const std::string&, const std::string&, int); \
+  template std::size_t decodeFile<alphabet_>( \
+      const std::string&, const std::string&);
+
+ONDRART_BASE64_FILE(AlphabetStandard)
+ONDRART_BASE64_FILE(AlphabetNoPadding<AlphabetStandard>)
+ONDRART_BASE64_FILE(AlphabetUrl)
+ONDRART_BASE64_FILE(AlphabetNoPadding<AlphabetUrl>)
+ONDRART_BASE64_FILE(AlphabetMime)
+
+#undef ONDRART_BASE64_FILE
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
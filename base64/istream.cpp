@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+
+#include <ondrart/base64/istream.h>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+template<typename Alphabet_>
+BasicIStreamBuffer<Alphabet_>::BasicIStreamBuffer(
+    std::istream* source_) :
+  source(source_),
+  raw(RAW_SIZE),
+  buffer(BUFFER_SIZE),
+  decoder() {
+  assert(source != nullptr);
+
+  setg(buffer.data(), buffer.data(), buffer.data());
+}
+
+template<typename Alphabet_>
+BasicIStreamBuffer<Alphabet_>::~BasicIStreamBuffer() {
+
+}
+
+template<typename Alphabet_>
+typename BasicIStreamBuffer<Alphabet_>::int_type
+BasicIStreamBuffer<Alphabet_>::underflow() {
+  if(gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+
+  std::size_t decoded_(0);
+  while(decoded_ == 0) {
+    /* -- read next block of the encoded data */
+    source->read(raw.data(), RAW_SIZE);
+    const std::streamsize length_(source->gcount());
+    if(length_ <= 0) {
+      decoder.finish();
+      setg(buffer.data(), buffer.data(), buffer.data());
+      return traits_type::eof();
+    }
+
+    /* -- decode it */
+    decoded_ = decoder.decode(
+        raw.data(), length_, buffer.data(), buffer.size());
+  }
+
+  setg(buffer.data(), buffer.data(), buffer.data() + decoded_);
+  return traits_type::to_int_type(*gptr());
+}
+
+template<typename Alphabet_>
+BasicIStream<Alphabet_>::BasicIStream(
+    std::istream* source_) :
+  std::istream(&buffer),
+  buffer(source_) {
+
+}
+
+template<typename Alphabet_>
+BasicIStream<Alphabet_>::~BasicIStream() {
+
+}
+
+template class BasicIStreamBuffer<AlphabetStandard>;
+template class BasicIStreamBuffer<AlphabetNoPadding<AlphabetStandard>>;
+template class BasicIStreamBuffer<AlphabetUrl>;
+template class BasicIStreamBuffer<AlphabetNoPadding<AlphabetUrl>>;
+template class BasicIStreamBuffer<AlphabetMime>;
+
+template class BasicIStream<AlphabetStandard>;
+template class BasicIStream<AlphabetNoPadding<AlphabetStandard>>;
+template class BasicIStream<AlphabetUrl>;
+template class BasicIStream<AlphabetNoPadding<AlphabetUrl>>;
+template class BasicIStream<AlphabetMime>;
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
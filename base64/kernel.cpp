@@ -0,0 +1,465 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kernel.h"
+
+#include <assert.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ONDRART_BASE64_X86 1
+#include <immintrin.h>
+#endif
+
+namespace OndraRT {
+
+namespace Base64 {
+
+namespace Kernel {
+
+namespace {
+
+template<char C62_, char C63_>
+class Tables {
+  public:
+    static_assert(
+        !(C62_ >= 'A' && C62_ <= 'Z') && !(C62_ >= 'a' && C62_ <= 'z')
+            && !(C62_ >= '0' && C62_ <= '9') && C62_ != '=',
+        "invalid character of the value 62");
+    static_assert(
+        !(C63_ >= 'A' && C63_ <= 'Z') && !(C63_ >= 'a' && C63_ <= 'z')
+            && !(C63_ >= '0' && C63_ <= '9') && C63_ != '=' && C63_ != C62_,
+        "invalid character of the value 63");
+
+    Tables() {
+      const char letters_[] =
+          "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+      for(int i_(0); i_ < 62; ++i_)
+        encode[i_] = letters_[i_];
+      encode[62] = C62_;
+      encode[63] = C63_;
+
+      for(int i_(0); i_ < 256; ++i_)
+        decode[i_] = -1;
+      for(int i_(0); i_ < 64; ++i_)
+        decode[static_cast<std::uint8_t>(encode[i_])] = i_;
+    }
+
+    static const Tables& instance() {
+      static const Tables tables_;
+      return tables_;
+    }
+
+    char encode[64];
+    std::int8_t decode[256];
+};
+
+typedef void (*EncodeFunc)(const std::uint8_t*, std::size_t, char*);
+typedef std::size_t (*DecodeFunc)(const char*, std::size_t, std::uint8_t*);
+
+template<char C62_, char C63_>
+void encodeScalar(
+    const std::uint8_t* input_,
+    std::size_t triplets_,
+    char* output_) {
+  const char* table_(Tables<C62_, C63_>::instance().encode);
+  for(; triplets_ > 0; --triplets_) {
+    const std::uint32_t value_(
+        (std::uint32_t(input_[0]) << 16)
+        | (std::uint32_t(input_[1]) << 8)
+        | std::uint32_t(input_[2]));
+    output_[0] = table_[(value_ >> 18) & 0x3f];
+    output_[1] = table_[(value_ >> 12) & 0x3f];
+    output_[2] = table_[(value_ >> 6) & 0x3f];
+    output_[3] = table_[value_ & 0x3f];
+    input_ += 3;
+    output_ += 4;
+  }
+}
+
+template<char C62_, char C63_>
+std::size_t decodeScalar(
+    const char* input_,
+    std::size_t quads_,
+    std::uint8_t* output_) {
+  const std::int8_t* table_(Tables<C62_, C63_>::instance().decode);
+  std::size_t decoded_(0);
+  for(; decoded_ < quads_; ++decoded_) {
+    const int a_(table_[static_cast<std::uint8_t>(input_[0])]);
+    const int b_(table_[static_cast<std::uint8_t>(input_[1])]);
+    const int c_(table_[static_cast<std::uint8_t>(input_[2])]);
+    const int d_(table_[static_cast<std::uint8_t>(input_[3])]);
+    if((a_ | b_ | c_ | d_) < 0)
+      break;
+    const std::uint32_t value_((a_ << 18) | (b_ << 12) | (c_ << 6) | d_);
+    output_[0] = static_cast<std::uint8_t>(value_ >> 16);
+    output_[1] = static_cast<std::uint8_t>(value_ >> 8);
+    output_[2] = static_cast<std::uint8_t>(value_);
+    input_ += 4;
+    output_ += 3;
+  }
+  return decoded_;
+}
+
+#if defined(ONDRART_BASE64_X86)
+
+/* -- The vector kernels follow the well known approach of W. Mula and
+ *    D. Lemire: the bytes are reshuffled so that every 32-bit lane holds
+ *    one triplet, the four 6-bit indexes are extracted by multiplications
+ *    and finally translated into ASCII by a small lookup of offsets. */
+
+__attribute__((target("ssse3")))
+inline __m128i reshuffle128(
+    __m128i in_) {
+  in_ = _mm_shuffle_epi8(
+      in_, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0_(_mm_and_si128(in_, _mm_set1_epi32(0x0fc0fc00)));
+  const __m128i t1_(_mm_mulhi_epu16(t0_, _mm_set1_epi32(0x04000040)));
+  const __m128i t2_(_mm_and_si128(in_, _mm_set1_epi32(0x003f03f0)));
+  const __m128i t3_(_mm_mullo_epi16(t2_, _mm_set1_epi32(0x01000010)));
+  return _mm_or_si128(t1_, t3_);
+}
+
+template<char C62_, char C63_>
+__attribute__((target("ssse3")))
+inline __m128i translate128(
+    __m128i in_) {
+  const __m128i lut_(_mm_setr_epi8(
+      'A', 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, C62_ - 62, C63_ - 63,
+      0, 0));
+  __m128i indices_(_mm_subs_epu8(in_, _mm_set1_epi8(51)));
+  const __m128i mask_(_mm_cmpgt_epi8(in_, _mm_set1_epi8(25)));
+  indices_ = _mm_sub_epi8(indices_, mask_);
+  return _mm_add_epi8(in_, _mm_shuffle_epi8(lut_, indices_));
+}
+
+template<char C62_, char C63_>
+__attribute__((target("ssse3")))
+void encodeSsse3(
+    const std::uint8_t* input_,
+    std::size_t triplets_,
+    char* output_) {
+  /* -- 12 bytes are consumed but 16 bytes are read */
+  while(triplets_ >= 6) {
+    __m128i in_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input_)));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(output_),
+        translate128<C62_, C63_>(reshuffle128(in_)));
+    input_ += 12;
+    output_ += 16;
+    triplets_ -= 4;
+  }
+  encodeScalar<C62_, C63_>(input_, triplets_, output_);
+}
+
+__attribute__((target("avx2")))
+inline __m256i reshuffle256(
+    __m256i in_) {
+  in_ = _mm256_shuffle_epi8(
+      in_, _mm256_set_epi8(
+          10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+          10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m256i t0_(_mm256_and_si256(in_, _mm256_set1_epi32(0x0fc0fc00)));
+  const __m256i t1_(_mm256_mulhi_epu16(t0_, _mm256_set1_epi32(0x04000040)));
+  const __m256i t2_(_mm256_and_si256(in_, _mm256_set1_epi32(0x003f03f0)));
+  const __m256i t3_(_mm256_mullo_epi16(t2_, _mm256_set1_epi32(0x01000010)));
+  return _mm256_or_si256(t1_, t3_);
+}
+
+template<char C62_, char C63_>
+__attribute__((target("avx2")))
+inline __m256i translate256(
+    __m256i in_) {
+  const __m256i lut_(_mm256_setr_epi8(
+      'A', 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, C62_ - 62, C63_ - 63,
+      0, 0,
+      'A', 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, C62_ - 62, C63_ - 63,
+      0, 0));
+  __m256i indices_(_mm256_subs_epu8(in_, _mm256_set1_epi8(51)));
+  const __m256i mask_(_mm256_cmpgt_epi8(in_, _mm256_set1_epi8(25)));
+  indices_ = _mm256_sub_epi8(indices_, mask_);
+  return _mm256_add_epi8(in_, _mm256_shuffle_epi8(lut_, indices_));
+}
+
+template<char C62_, char C63_>
+__attribute__((target("avx2")))
+void encodeAvx2(
+    const std::uint8_t* input_,
+    std::size_t triplets_,
+    char* output_) {
+  /* -- 24 bytes are consumed, the second lane reads 16 bytes at offset 12 */
+  while(triplets_ >= 10) {
+    const __m128i lo_(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input_)));
+    const __m128i hi_(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input_ + 12)));
+    const __m256i in_(
+        _mm256_inserti128_si256(_mm256_castsi128_si256(lo_), hi_, 1));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(output_),
+        translate256<C62_, C63_>(reshuffle256(in_)));
+    input_ += 24;
+    output_ += 32;
+    triplets_ -= 8;
+  }
+  encodeSsse3<C62_, C63_>(input_, triplets_, output_);
+}
+
+/* -- The decoding kernels classify the characters by range comparisons.
+ *    Every valid character gets an offset moving it to its 6-bit value,
+ *    a block containing anything else is left to the scalar code. The
+ *    values are packed back by multiply-add instructions. */
+
+template<char C62_, char C63_>
+__attribute__((target("ssse3")))
+inline __m128i translateBack128(
+    __m128i in_,
+    __m128i& valid_) {
+  const __m128i upper_(_mm_and_si128(
+      _mm_cmpgt_epi8(in_, _mm_set1_epi8('A' - 1)),
+      _mm_cmplt_epi8(in_, _mm_set1_epi8('Z' + 1))));
+  const __m128i lower_(_mm_and_si128(
+      _mm_cmpgt_epi8(in_, _mm_set1_epi8('a' - 1)),
+      _mm_cmplt_epi8(in_, _mm_set1_epi8('z' + 1))));
+  const __m128i digit_(_mm_and_si128(
+      _mm_cmpgt_epi8(in_, _mm_set1_epi8('0' - 1)),
+      _mm_cmplt_epi8(in_, _mm_set1_epi8('9' + 1))));
+  const __m128i c62_(_mm_cmpeq_epi8(in_, _mm_set1_epi8(C62_)));
+  const __m128i c63_(_mm_cmpeq_epi8(in_, _mm_set1_epi8(C63_)));
+
+  valid_ = _mm_or_si128(
+      _mm_or_si128(upper_, lower_),
+      _mm_or_si128(digit_, _mm_or_si128(c62_, c63_)));
+
+  __m128i offset_(_mm_and_si128(upper_, _mm_set1_epi8(-'A')));
+  offset_ = _mm_or_si128(
+      offset_, _mm_and_si128(lower_, _mm_set1_epi8(26 - 'a')));
+  offset_ = _mm_or_si128(
+      offset_, _mm_and_si128(digit_, _mm_set1_epi8(52 - '0')));
+  offset_ = _mm_or_si128(
+      offset_, _mm_and_si128(c62_, _mm_set1_epi8(62 - C62_)));
+  offset_ = _mm_or_si128(
+      offset_, _mm_and_si128(c63_, _mm_set1_epi8(63 - C63_)));
+  return _mm_add_epi8(in_, offset_);
+}
+
+__attribute__((target("ssse3")))
+inline __m128i pack128(
+    __m128i in_) {
+  const __m128i ab_bc_(_mm_maddubs_epi16(in_, _mm_set1_epi32(0x01400140)));
+  const __m128i abc_(_mm_madd_epi16(ab_bc_, _mm_set1_epi32(0x00011000)));
+  return _mm_shuffle_epi8(
+      abc_,
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+template<char C62_, char C63_>
+__attribute__((target("ssse3")))
+std::size_t decodeSsse3(
+    const char* input_,
+    std::size_t quads_,
+    std::uint8_t* output_) {
+  /* -- 16 bytes are stored but only 12 of them are valid */
+  std::size_t decoded_(0);
+  while(quads_ - decoded_ >= 6) {
+    __m128i valid_;
+    const __m128i in_(translateBack128<C62_, C63_>(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input_)), valid_));
+    if(_mm_movemask_epi8(valid_) != 0xffff)
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output_), pack128(in_));
+    input_ += 16;
+    output_ += 12;
+    decoded_ += 4;
+  }
+  return decoded_
+      + decodeScalar<C62_, C63_>(input_, quads_ - decoded_, output_);
+}
+
+template<char C62_, char C63_>
+__attribute__((target("avx2")))
+inline __m256i translateBack256(
+    __m256i in_,
+    __m256i& valid_) {
+  const __m256i upper_(_mm256_and_si256(
+      _mm256_cmpgt_epi8(in_, _mm256_set1_epi8('A' - 1)),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), in_)));
+  const __m256i lower_(_mm256_and_si256(
+      _mm256_cmpgt_epi8(in_, _mm256_set1_epi8('a' - 1)),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), in_)));
+  const __m256i digit_(_mm256_and_si256(
+      _mm256_cmpgt_epi8(in_, _mm256_set1_epi8('0' - 1)),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), in_)));
+  const __m256i c62_(_mm256_cmpeq_epi8(in_, _mm256_set1_epi8(C62_)));
+  const __m256i c63_(_mm256_cmpeq_epi8(in_, _mm256_set1_epi8(C63_)));
+
+  valid_ = _mm256_or_si256(
+      _mm256_or_si256(upper_, lower_),
+      _mm256_or_si256(digit_, _mm256_or_si256(c62_, c63_)));
+
+  __m256i offset_(_mm256_and_si256(upper_, _mm256_set1_epi8(-'A')));
+  offset_ = _mm256_or_si256(
+      offset_, _mm256_and_si256(lower_, _mm256_set1_epi8(26 - 'a')));
+  offset_ = _mm256_or_si256(
+      offset_, _mm256_and_si256(digit_, _mm256_set1_epi8(52 - '0')));
+  offset_ = _mm256_or_si256(
+      offset_, _mm256_and_si256(c62_, _mm256_set1_epi8(62 - C62_)));
+  offset_ = _mm256_or_si256(
+      offset_, _mm256_and_si256(c63_, _mm256_set1_epi8(63 - C63_)));
+  return _mm256_add_epi8(in_, offset_);
+}
+
+__attribute__((target("avx2")))
+inline __m256i pack256(
+    __m256i in_) {
+  const __m256i ab_bc_(
+      _mm256_maddubs_epi16(in_, _mm256_set1_epi32(0x01400140)));
+  const __m256i abc_(_mm256_madd_epi16(ab_bc_, _mm256_set1_epi32(0x00011000)));
+  const __m256i lanes_(_mm256_shuffle_epi8(
+      abc_,
+      _mm256_setr_epi8(
+          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+  return _mm256_permutevar8x32_epi32(
+      lanes_, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
+
+template<char C62_, char C63_>
+__attribute__((target("avx2")))
+std::size_t decodeAvx2(
+    const char* input_,
+    std::size_t quads_,
+    std::uint8_t* output_) {
+  /* -- 32 bytes are stored but only 24 of them are valid */
+  std::size_t decoded_(0);
+  while(quads_ - decoded_ >= 11) {
+    __m256i valid_;
+    const __m256i in_(translateBack256<C62_, C63_>(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input_)),
+        valid_));
+    if(_mm256_movemask_epi8(valid_) != -1)
+      break;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output_), pack256(in_));
+    input_ += 32;
+    output_ += 24;
+    decoded_ += 8;
+  }
+  return decoded_
+      + decodeSsse3<C62_, C63_>(input_, quads_ - decoded_, output_);
+}
+
+template<char C62_, char C63_>
+EncodeFunc selectEncoder() {
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2"))
+    return &encodeAvx2<C62_, C63_>;
+  if(__builtin_cpu_supports("ssse3"))
+    return &encodeSsse3<C62_, C63_>;
+  return &encodeScalar<C62_, C63_>;
+}
+
+template<char C62_, char C63_>
+DecodeFunc selectDecoder() {
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2"))
+    return &decodeAvx2<C62_, C63_>;
+  if(__builtin_cpu_supports("ssse3"))
+    return &decodeSsse3<C62_, C63_>;
+  return &decodeScalar<C62_, C63_>;
+}
+
+#else
+
+template<char C62_, char C63_>
+EncodeFunc selectEncoder() {
+  return &encodeScalar<C62_, C63_>;
+}
+
+template<char C62_, char C63_>
+DecodeFunc selectDecoder() {
+  return &decodeScalar<C62_, C63_>;
+}
+
+#endif /* -- ONDRART_BASE64_X86 */
+
+} /* -- namespace */
+
+template<char C62_, char C63_>
+void encodeTriplets(
+    const std::uint8_t* input_,
+    std::size_t triplets_,
+    char* output_) {
+  static const EncodeFunc encoder_(selectEncoder<C62_, C63_>());
+  encoder_(input_, triplets_, output_);
+}
+
+template<char C62_, char C63_>
+void encodeTail(
+    const std::uint8_t* input_,
+    std::size_t length_,
+    char* output_) {
+  assert(length_ == 1 || length_ == 2);
+
+  const char* table_(Tables<C62_, C63_>::instance().encode);
+  output_[0] = table_[(input_[0] & 0xfc) >> 2];
+  if(length_ == 1) {
+    output_[1] = table_[(input_[0] & 0x03) << 4];
+  }
+  else {
+    output_[1] = table_[((input_[0] & 0x03) << 4) | ((input_[1] & 0xf0) >> 4)];
+    output_[2] = table_[(input_[1] & 0x0f) << 2];
+  }
+}
+
+template<char C62_, char C63_>
+std::size_t decodeQuads(
+    const char* input_,
+    std::size_t quads_,
+    std::uint8_t* output_) {
+  static const DecodeFunc decoder_(selectDecoder<C62_, C63_>());
+  return decoder_(input_, quads_, output_);
+}
+
+template<char C62_, char C63_>
+int decodeChar(
+    char c_) {
+  return Tables<C62_, C63_>::instance().decode[static_cast<std::uint8_t>(c_)];
+}
+
+#define ONDRART_BASE64_KERNEL(c62_, c63_) \
+  template void encodeTriplets<c62_, c63_>( \
+      const std::uint8_t*, std::size_t, char*); \
+  template void encodeTail<c62_, c63_>( \
+      const std::uint8_t*, std::size_t, char*); \
+  template std::size_t decodeQuads<c62_, c63_>( \
+      const char*, std::size_t, std::uint8_t*); \
+  template int decodeChar<c62_, c63_>(char);
+
+ONDRART_BASE64_KERNEL('+', '/')
+ONDRART_BASE64_KERNEL('-', '_')
+
+#undef ONDRART_BASE64_KERNEL
+
+} /* -- namespace Kernel */
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
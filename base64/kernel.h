@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__BASE64_KERNEL_H_
+#define OndraRT__BASE64_KERNEL_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+namespace Kernel {
+
+/*
+ * The kernels are parametrized by the characters of the values 62 and 63.
+ * The rest of the alphabet is shared by all supported base64 variants.
+ * The kernels are instantiated for the pairs '+', '/' and '-', '_'.
+ */
+
+/**
+ * @brief Encode whole triplets
+ *
+ * The function picks the fastest implementation supported by the running
+ * CPU (AVX2, SSSE3 or the scalar one). The choice is made once at the first
+ * call.
+ *
+ * @param input_ The input bytes. Exactly 3 * @a triplets_ bytes are read.
+ * @param triplets_ Number of encoded triplets
+ * @param output_ Output buffer. Exactly 4 * @a triplets_ characters
+ *     are written.
+ */
+template<char C62_, char C63_>
+void encodeTriplets(
+    const std::uint8_t* input_,
+    std::size_t triplets_,
+    char* output_);
+
+/**
+ * @brief Encode the last incomplete triplet
+ *
+ * The padding is not written.
+ *
+ * @param input_ The input bytes
+ * @param length_ Number of the input bytes (1 or 2)
+ * @param output_ Output buffer. @a length_ + 1 characters are written.
+ */
+template<char C62_, char C63_>
+void encodeTail(
+    const std::uint8_t* input_,
+    std::size_t length_,
+    char* output_);
+
+/**
+ * @brief Decode leading valid quaternions
+ *
+ * The function decodes quaternions while they consist of the alphabet
+ * characters only. It stops at the first quaternion containing anything
+ * else (a whitespace, the padding or an invalid character). The choice
+ * of the implementation is the same as in the case of encodeTriplets().
+ *
+ * @param input_ The input characters. At most 4 * @a quads_ characters
+ *     are read.
+ * @param quads_ Number of available quaternions
+ * @param output_ Output buffer. It must be able to keep 3 * @a quads_ bytes.
+ * @return Number of decoded quaternions
+ */
+template<char C62_, char C63_>
+std::size_t decodeQuads(
+    const char* input_,
+    std::size_t quads_,
+    std::uint8_t* output_);
+
+/**
+ * @brief Decode one character
+ *
+ * @return The 6-bit value or -1 if the character is not part of
+ *     the alphabet
+ */
+template<char C62_, char C63_>
+int decodeChar(
+    char c_);
+
+} /* -- namespace Kernel */
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__BASE64_KERNEL_H_ */
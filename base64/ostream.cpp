@@ -18,17 +18,20 @@
  */
 
 #include <assert.h>
+#include <algorithm>
+#include <cstring>
+#include <thread>
 
 #include <ondrart/base64/ostream.h>
 
+#include "workers.h"
+
 namespace OndraRT {
 
 namespace Base64 {
 
 namespace {
 
-constexpr char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
 template<typename Src_>
 const std::uint8_t* toByteArray(
     const Src_* src_array_) {
@@ -36,109 +39,241 @@ const std::uint8_t* toByteArray(
   return reinterpret_cast<const std::uint8_t*>(src_array_);
 }
 
+std::unique_ptr<Workers> createWorkers(
+    int threads_) {
+  if(threads_ <= 0)
+    threads_ = std::thread::hardware_concurrency();
+  if(threads_ <= 1)
+    return nullptr;
+  return std::unique_ptr<Workers>(new Workers(threads_));
+}
+
 } /* -- namespace */
 
-void OStreamBuffer::pushTriplet(
-    const std::uint8_t* ibuff_,
-    const std::uint8_t* current_) {
-  if(ibuff_ < current_) {
-    char obuff_[4];
-    std::uint8_t c_((*ibuff_ & 0xfc) >> 2);
-    obuff_[0] = table[c_];
-
-    c_ = (*ibuff_ & 0x03) << 4;
-    ++ibuff_;
-    if(ibuff_ < current_)
-      c_ |= (*ibuff_ & 0xf0) >> 4;
-    obuff_[1] = table[c_];
-
-    if(ibuff_ < current_) {
-      c_ = (*ibuff_ & 0x0f) << 2;
-      ++ibuff_;
-      if(ibuff_ < current_)
-        c_ |= (*ibuff_ & 0xc0) >> 6;
-      obuff_[2] = table[c_];
-
-      if(ibuff_ < current_)
-        obuff_[3] = table[*ibuff_ & 0x3f];
-      else
-        obuff_[3] = '=';
-    }
-    else {
-      obuff_[2] = '=';
-      obuff_[3] = '=';
-    }
+template<typename Alphabet_>
+void BasicOStreamBuffer<Alphabet_>::encodeParallel(
+    const std::uint8_t* input_,
+    std::size_t length_) {
+  struct Piece {
+    BasicEncoder<Alphabet_> encoder;
+    const std::uint8_t* input;
+    std::size_t length;
+    char* output;
+    std::size_t size;
+  };
 
-    /* -- write the converted quaternion */
-    sink->write(obuff_, 4);
+  /* -- Split the block into pieces of whole triplets. Only the last piece
+   *    may contain an incomplete triplet. The encoder of each piece
+   *    starts at the line position where the previous piece ends,
+   *    hence the pieces can be simply concatenated. */
+  const std::size_t threads_(workers->getThreads());
+  const std::size_t piece_length_(
+      ((length_ + 2) / 3 + threads_ - 1) / threads_ * 3);
+  std::vector<Piece> pieces_;
+  pieces_.reserve(threads_);
+  BasicEncoder<Alphabet_> next_(encoder);
+  char* out_(output.data());
+  for(std::size_t offset_(0); offset_ < length_; offset_ += piece_length_) {
+    const std::size_t piece_(std::min(piece_length_, length_ - offset_));
+    const std::size_t size_(next_.getLength(piece_));
+    pieces_.push_back(Piece{next_, input_ + offset_, piece_, out_, size_});
+    out_ += size_;
+    if(piece_ % 3 == 0)
+      next_.advance(piece_);
+  }
+  assert(out_ <= output.data() + output.size());
 
-    /* -- break the line if it's needed */
-    if(len_quat > 0) {
-      ++quaternions;
-      if(quaternions >= len_quat) {
-        quaternions = 0;
-        *sink << '\n';
-      }
-    }
+  workers->run(
+      [&pieces_](int index_) {
+        Piece& piece_(pieces_[index_]);
+        piece_.encoder.encode(
+            piece_.input, piece_.length, piece_.output, piece_.size);
+      },
+      pieces_.size());
+
+  /* -- the encoder of the last piece knows the final line position */
+  encoder = pieces_.back().encoder;
+  sink->write(output.data(), out_ - output.data());
+}
+
+template<typename Alphabet_>
+void BasicOStreamBuffer<Alphabet_>::encodeBlock(
+    const std::uint8_t* input_,
+    std::size_t length_) {
+  assert(length_ <= buffer_size);
+
+  /* -- the parallel encoding doesn't pay off for small blocks */
+  if(workers != nullptr && length_ >= 2 * BLOCK_SIZE) {
+    encodeParallel(input_, length_);
+    return;
   }
+
+  const std::size_t encoded_(
+      encoder.encode(input_, length_, output.data(), output.size()));
+  if(encoded_ > 0)
+    sink->write(output.data(), encoded_);
 }
 
-OStreamBuffer::OStreamBuffer(
+template<typename Alphabet_>
+void BasicOStreamBuffer<Alphabet_>::encodePending() {
+  /* -- encode whole triplets */
+  const std::size_t length_(pptr() - pbase());
+  const std::size_t rest_(length_ % 3);
+  encodeBlock(toByteArray(pbase()), length_ - rest_);
+
+  /* -- keep the incomplete triplet at the beginning of the buffer */
+  std::copy(pptr() - rest_, pptr(), buffer.data());
+  setp(buffer.data(), buffer.data() + buffer_size);
+  pbump(rest_);
+}
+
+template<typename Alphabet_>
+BasicOStreamBuffer<Alphabet_>::BasicOStreamBuffer(
     std::ostream* sink_,
-    int quaternions_) :
+    int quaternions_,
+    int threads_) :
+  stream_sink(new SinkOStream(sink_)),
+  sink(stream_sink.get()),
+  encoder((quaternions_ > 0)?(quaternions_ * 4):-1),
+  workers(createWorkers(threads_)),
+  buffer_size(
+      (workers != nullptr)?(workers->getThreads() * PIECE_SIZE):BLOCK_SIZE),
+  buffer(buffer_size),
+  /* -- quaternions, line breaks and the padding */
+  output(buffer_size / 3 * 6 + 6) {
+  setp(buffer.data(), buffer.data() + buffer_size);
+}
+
+template<typename Alphabet_>
+BasicOStreamBuffer<Alphabet_>::BasicOStreamBuffer(
+    Sink* sink_,
+    int quaternions_,
+    int threads_) :
   sink(sink_),
-  len_quat(quaternions_),
-  quaternions(0) {
+  encoder((quaternions_ > 0)?(quaternions_ * 4):-1),
+  workers(createWorkers(threads_)),
+  buffer_size(
+      (workers != nullptr)?(workers->getThreads() * PIECE_SIZE):BLOCK_SIZE),
+  buffer(buffer_size),
+  /* -- quaternions, line breaks and the padding */
+  output(buffer_size / 3 * 6 + 6) {
   assert(sink != nullptr);
 
-  setp(buffer, buffer + BUFFER_SIZE);
+  setp(buffer.data(), buffer.data() + buffer_size);
 }
 
-OStreamBuffer::~OStreamBuffer() {
-  /* -- write the remaining data with padding */
-  pushTriplet(toByteArray(buffer), toByteArray(pptr()));
+template<typename Alphabet_>
+BasicOStreamBuffer<Alphabet_>::~BasicOStreamBuffer() {
+  /* -- write the remaining data with padding, the errors cannot be
+   *    reported from the destructor */
+  try {
+    encodeBlock(toByteArray(pbase()), pptr() - pbase());
+  }
+  catch(...) {
+
+  }
 }
 
-OStreamBuffer::int_type OStreamBuffer::overflow(
-    OStreamBuffer::int_type ch) {
-  /* -- write the triplet */
-  pushTriplet(toByteArray(buffer), toByteArray(pptr()));
+template<typename Alphabet_>
+typename BasicOStreamBuffer<Alphabet_>::int_type
+BasicOStreamBuffer<Alphabet_>::overflow(
+    int_type ch) {
+  /* -- encode the full buffer */
+  encodePending();
 
   /* -- start new one */
-  char* begin_(buffer);
   if(ch != traits_type::eof()) {
-    buffer[0] = traits_type::to_char_type(ch);
-    ++begin_;
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
   }
-  setp(begin_, buffer + BUFFER_SIZE);
 
   return traits_type::not_eof(ch);
 }
 
-void OStreamBuffer::finish() {
+template<typename Alphabet_>
+std::streamsize BasicOStreamBuffer<Alphabet_>::xsputn(
+    const char_type* s,
+    std::streamsize n) {
+  std::streamsize written_(0);
+  while(written_ < n) {
+    if(pptr() == epptr()) {
+      encodePending();
+    }
+    else if(pptr() == pbase()
+        && n - written_ >= static_cast<std::streamsize>(buffer_size)) {
+      /* -- large blocks are encoded directly without copying */
+      encodeBlock(toByteArray(s + written_), buffer_size);
+      written_ += buffer_size;
+    }
+    else {
+      const std::streamsize chunk_(
+          std::min<std::streamsize>(epptr() - pptr(), n - written_));
+      std::memcpy(pptr(), s + written_, chunk_);
+      pbump(chunk_);
+      written_ += chunk_;
+    }
+  }
+  return n;
+}
+
+template<typename Alphabet_>
+int BasicOStreamBuffer<Alphabet_>::sync() {
+  encodePending();
+  sink->flush();
+  return 0;
+}
+
+template<typename Alphabet_>
+void BasicOStreamBuffer<Alphabet_>::finish() {
   /* -- write the remaining data with padding */
-  pushTriplet(toByteArray(buffer), toByteArray(pptr()));
+  encodeBlock(toByteArray(pbase()), pptr() - pbase());
 
   /* -- prepare for next triplet */
-  setp(buffer, buffer + BUFFER_SIZE);
+  setp(buffer.data(), buffer.data() + buffer_size);
 }
 
-OStream::OStream(
+template<typename Alphabet_>
+BasicOStream<Alphabet_>::BasicOStream(
     std::ostream* os_,
-    int line_length_) :
+    int line_length_,
+    int threads_) :
   std::ostream(&buffer),
-  buffer(os_, (line_length_ <= 3)?-1:(line_length_ / 4)) {
+  buffer(os_, (line_length_ <= 3)?-1:(line_length_ / 4), threads_) {
 
 }
 
-OStream::~OStream() {
+template<typename Alphabet_>
+BasicOStream<Alphabet_>::BasicOStream(
+    Sink* sink_,
+    int line_length_,
+    int threads_) :
+  std::ostream(&buffer),
+  buffer(sink_, (line_length_ <= 3)?-1:(line_length_ / 4), threads_) {
 
 }
 
-void OStream::finish() {
+template<typename Alphabet_>
+BasicOStream<Alphabet_>::~BasicOStream() {
+
+}
+
+template<typename Alphabet_>
+void BasicOStream<Alphabet_>::finish() {
   buffer.finish();
 }
 
+template class BasicOStreamBuffer<AlphabetStandard>;
+template class BasicOStreamBuffer<AlphabetNoPadding<AlphabetStandard>>;
+template class BasicOStreamBuffer<AlphabetUrl>;
+template class BasicOStreamBuffer<AlphabetNoPadding<AlphabetUrl>>;
+template class BasicOStreamBuffer<AlphabetMime>;
+
+template class BasicOStream<AlphabetStandard>;
+template class BasicOStream<AlphabetNoPadding<AlphabetStandard>>;
+template class BasicOStream<AlphabetUrl>;
+template class BasicOStream<AlphabetNoPadding<AlphabetUrl>>;
+template class BasicOStream<AlphabetMime>;
+
 } /* -- namespace Base64 */
 
 } /* -- namespace OndraRT */
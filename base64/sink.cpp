@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ondrart/base64/sink.h>
+
+#include <assert.h>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <utility>
+
+#include <ondrart/base64/base64error.h>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+Sink::Sink() {
+
+}
+
+Sink::~Sink() {
+
+}
+
+void Sink::flush() {
+
+}
+
+SinkOStream::SinkOStream(
+    std::ostream* os_) :
+  os(os_) {
+  assert(os != nullptr);
+
+}
+
+SinkOStream::~SinkOStream() {
+
+}
+
+void SinkOStream::write(
+    const char* data_,
+    std::size_t length_) {
+  os->write(data_, length_);
+}
+
+void SinkOStream::flush() {
+  os->flush();
+}
+
+SinkFd::SinkFd(
+    int fd_) :
+  fd(fd_) {
+  assert(fd >= 0);
+
+}
+
+SinkFd::~SinkFd() {
+
+}
+
+void SinkFd::write(
+    const char* data_,
+    std::size_t length_) {
+  while(length_ > 0) {
+    const ssize_t written_(::write(fd, data_, length_));
+    if(written_ < 0) {
+      if(errno == EINTR)
+        continue;
+      throw Base64Error(
+          std::string("base64 sink cannot write: ") + std::strerror(errno));
+    }
+    data_ += written_;
+    length_ -= written_;
+  }
+}
+
+SinkCallback::SinkCallback(
+    Callback callback_) :
+  callback(std::move(callback_)) {
+
+}
+
+SinkCallback::~SinkCallback() {
+
+}
+
+void SinkCallback::write(
+    const char* data_,
+    std::size_t length_) {
+  callback(data_, length_);
+}
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
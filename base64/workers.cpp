@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "workers.h"
+
+#include <assert.h>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+Workers::Workers(
+    int threads_) :
+  task(nullptr),
+  count(0),
+  next(0),
+  remaining(0),
+  stopping(false) {
+  assert(threads_ > 0);
+
+  for(int i_(1); i_ < threads_; ++i_)
+    threads.emplace_back(&Workers::worker, this);
+}
+
+Workers::~Workers() {
+  {
+    std::lock_guard<std::mutex> lock_(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for(auto& thread_ : threads)
+    thread_.join();
+}
+
+int Workers::getThreads() const noexcept {
+  return threads.size() + 1;
+}
+
+void Workers::work(
+    std::unique_lock<std::mutex>& lock_) {
+  while(next < count) {
+    const int index_(next++);
+    lock_.unlock();
+    try {
+      (*task)(index_);
+    }
+    catch(...) {
+      lock_.lock();
+      if(!error)
+        error = std::current_exception();
+      lock_.unlock();
+    }
+    lock_.lock();
+    if(--remaining == 0)
+      done.notify_all();
+  }
+}
+
+void Workers::worker() {
+  std::unique_lock<std::mutex> lock_(mutex);
+  while(true) {
+    wake.wait(lock_, [this]{ return stopping || next < count; });
+    if(stopping)
+      return;
+    work(lock_);
+  }
+}
+
+void Workers::run(
+    const std::function<void(int)>& task_,
+    int count_) {
+  std::unique_lock<std::mutex> lock_(mutex);
+  task = &task_;
+  count = count_;
+  next = 0;
+  remaining = count_;
+  error = nullptr;
+  wake.notify_all();
+
+  /* -- help the workers and wait for the rest of the batch */
+  work(lock_);
+  done.wait(lock_, [this]{ return remaining == 0; });
+  count = 0;
+  next = 0;
+  task = nullptr;
+
+  if(error)
+    std::rethrow_exception(error);
+}
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__BASE64_WORKERS_H_
+#define OndraRT__BASE64_WORKERS_H_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+/**
+ * @brief A simple pool of worker threads
+ *
+ * The pool runs batches of indexed tasks. The calling thread takes part
+ * in the work, so a pool of N threads starts N - 1 worker threads.
+ */
+class Workers {
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param threads_ Number of threads working on a batch (including
+     *     the calling one)
+     */
+    explicit Workers(
+        int threads_);
+
+    /**
+     * @brief Dtor
+     */
+    ~Workers();
+
+    /* -- avoid copying */
+    Workers(
+        const Workers&) = delete;
+    Workers& operator =(
+        const Workers&) = delete;
+
+    /**
+     * @brief Get number of threads working on a batch
+     */
+    int getThreads() const noexcept;
+
+    /**
+     * @brief Run a batch of tasks and wait for its completion
+     *
+     * @param task_ The task. It's invoked with indexes 0 .. @a count_ - 1.
+     * @param count_ Number of the tasks
+     * @exception The first exception thrown by a task is rethrown
+     */
+    void run(
+        const std::function<void(int)>& task_,
+        int count_);
+
+  private:
+    void work(
+        std::unique_lock<std::mutex>& lock_);
+    void worker();
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(int)>* task;
+    int count;
+    int next;
+    int remaining;
+    bool stopping;
+    std::exception_ptr error;
+};
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__BASE64_WORKERS_H_ */
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Throughput benchmark of the base64 output stream
+ *
+ * The benchmark measures the encoding speed (MB/s of the input data)
+ * of the Base64::OStream for a range of input sizes, line lengths,
+ * sinks and write granularities. The results are printed in the CSV
+ * (default) or JSON format so they can be compared between versions.
+ *
+ * Usage: base64_bench [--min-size N] [--max-size N] [--min-time SECONDS]
+ *                     [--threads N] [--format csv|json]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ondrart/base64/ostream.h>
+
+namespace B = ::OndraRT::Base64;
+
+namespace {
+
+enum Sink {
+  SINK_STRING = 0,
+  SINK_DEVNULL,
+};
+
+enum Granularity {
+  GRANULARITY_PUT = 0,
+  GRANULARITY_WRITE,
+};
+
+const char* const SINK_NAMES[] = {"ostringstream", "devnull"};
+const char* const GRANULARITY_NAMES[] = {"put", "write"};
+
+struct Options {
+  std::size_t min_size;
+  std::size_t max_size;
+  double min_time;
+  int threads;
+  bool json;
+};
+
+struct Result {
+  std::size_t size;
+  int line_length;
+  Sink sink;
+  Granularity granularity;
+  std::size_t iterations;
+  double seconds;
+};
+
+void printHelp(
+    const char* program_) {
+  std::cerr
+      << "usage: " << program_ << " [--min-size N] [--max-size N]"
+      << " [--min-time SECONDS] [--threads N] [--format csv|json]\n";
+}
+
+bool parseOptions(
+    int argc_,
+    char* argv_[],
+    Options& options_) {
+  options_.min_size = 16;
+  options_.max_size = std::size_t(1) << 30;
+  options_.min_time = 0.2;
+  options_.threads = 1;
+  options_.json = false;
+
+  for(int i_(1); i_ < argc_; ++i_) {
+    const char* arg_(argv_[i_]);
+    if(i_ + 1 >= argc_)
+      return false;
+    const char* value_(argv_[++i_]);
+    if(std::strcmp(arg_, "--min-size") == 0)
+      options_.min_size = std::strtoull(value_, nullptr, 10);
+    else if(std::strcmp(arg_, "--max-size") == 0)
+      options_.max_size = std::strtoull(value_, nullptr, 10);
+    else if(std::strcmp(arg_, "--min-time") == 0)
+      options_.min_time = std::strtod(value_, nullptr);
+    else if(std::strcmp(arg_, "--threads") == 0)
+      options_.threads = std::atoi(value_);
+    else if(std::strcmp(arg_, "--format") == 0 && std::strcmp(value_, "csv") == 0)
+      options_.json = false;
+    else if(std::strcmp(arg_, "--format") == 0 && std::strcmp(value_, "json") == 0)
+      options_.json = true;
+    else
+      return false;
+  }
+  return options_.min_size > 0 && options_.min_size <= options_.max_size;
+}
+
+void encode(
+    const char* input_,
+    std::size_t size_,
+    B::OStream& os_,
+    Granularity granularity_) {
+  if(granularity_ == GRANULARITY_PUT) {
+    for(std::size_t i_(0); i_ < size_; ++i_)
+      os_.put(input_[i_]);
+  }
+  else {
+    os_.write(input_, size_);
+  }
+  os_.finish();
+}
+
+Result measure(
+    const char* input_,
+    std::size_t size_,
+    int line_length_,
+    Sink sink_,
+    Granularity granularity_,
+    const Options& options_) {
+  typedef std::chrono::steady_clock Clock;
+
+  std::ostringstream string_sink_;
+  std::ofstream null_sink_;
+  std::ostream* sink_stream_(&string_sink_);
+  if(sink_ == SINK_DEVNULL) {
+    null_sink_.open("/dev/null", std::ios::out | std::ios::binary);
+    sink_stream_ = &null_sink_;
+  }
+
+  /* -- The stream is created once for all iterations as its buffers
+   *    (and the threads in the parallel mode) would dominate the time
+   *    of small inputs. */
+  B::OStream os_(sink_stream_, line_length_, options_.threads);
+
+  Result result_{size_, line_length_, sink_, granularity_, 0, 0.0};
+  const Clock::time_point start_(Clock::now());
+  do {
+    if(sink_ == SINK_STRING)
+      string_sink_.str(std::string());
+    encode(input_, size_, os_, granularity_);
+    ++result_.iterations;
+    result_.seconds = std::chrono::duration<double>(Clock::now() - start_).count();
+  } while(result_.seconds < options_.min_time);
+
+  return result_;
+}
+
+double throughput(
+    const Result& result_) {
+  return static_cast<double>(result_.size) * result_.iterations
+      / result_.seconds / 1e6;
+}
+
+void printCsvHeader() {
+  std::cout
+      << "size,line_length,sink,granularity,threads,iterations,seconds,mb_per_s"
+      << std::endl;
+}
+
+void printCsv(
+    const Result& result_,
+    const Options& options_) {
+  std::cout
+      << result_.size << ','
+      << result_.line_length << ','
+      << SINK_NAMES[result_.sink] << ','
+      << GRANULARITY_NAMES[result_.granularity] << ','
+      << options_.threads << ','
+      << result_.iterations << ','
+      << result_.seconds << ','
+      << throughput(result_) << std::endl;
+}
+
+void printJson(
+    const Result& result_,
+    const Options& options_,
+    bool first_) {
+  std::cout
+      << (first_ ? "[\n" : ",\n")
+      << "  {\"size\": " << result_.size
+      << ", \"line_length\": " << result_.line_length
+      << ", \"sink\": \"" << SINK_NAMES[result_.sink] << '"'
+      << ", \"granularity\": \"" << GRANULARITY_NAMES[result_.granularity] << '"'
+      << ", \"threads\": " << options_.threads
+      << ", \"iterations\": " << result_.iterations
+      << ", \"seconds\": " << result_.seconds
+      << ", \"mb_per_s\": " << throughput(result_) << '}' << std::flush;
+}
+
+} /* -- namespace */
+
+int main(
+    int argc_,
+    char* argv_[]) {
+  Options options_;
+  if(!parseOptions(argc_, argv_, options_)) {
+    printHelp(argv_[0]);
+    return 1;
+  }
+
+  /* -- random data of the largest size, smaller inputs are its prefixes
+   *    (they are not copied) */
+  std::vector<char> data_(options_.max_size);
+  std::mt19937 generator_(42);
+  for(char& c_ : data_)
+    c_ = static_cast<char>(generator_());
+
+  const int line_lengths_[] = {-1, 76};
+  bool first_(true);
+  if(!options_.json)
+    printCsvHeader();
+  /* -- The sizes grow by 16 times. The last step is clamped so that
+   *    the maximal size is always measured. */
+  for(std::size_t size_(std::min(options_.min_size, options_.max_size));;
+      size_ = (size_ > options_.max_size / 16)
+          ? options_.max_size : size_ * 16) {
+    for(int line_length_ : line_lengths_) {
+      for(Sink sink_ : {SINK_STRING, SINK_DEVNULL}) {
+        for(Granularity granularity_ : {GRANULARITY_PUT, GRANULARITY_WRITE}) {
+          const Result result_(
+              measure(
+                  data_.data(),
+                  size_,
+                  line_length_,
+                  sink_,
+                  granularity_,
+                  options_));
+          if(options_.json)
+            printJson(result_, options_, first_);
+          else
+            printCsv(result_, options_);
+          first_ = false;
+        }
+      }
+    }
+    if(size_ >= options_.max_size)
+      break;
+  }
+  if(options_.json)
+    std::cout << (first_ ? "[]\n" : "\n]\n") << std::flush;
+
+  return 0;
+}
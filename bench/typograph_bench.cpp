@@ -0,0 +1,464 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Rendering benchmark of the typograph
+ *
+ * The benchmark measures the speed of Typograph::writeBlock() for several
+ * block trees: the example tree of the typograph, a deep nesting of boxes
+ * and attributes, a table of 50 columns (laid out serially
+ * and concurrently) and a long paragraph. The trees
+ * are rendered by the LineDriverIos and LineDriverPre drivers into
+ * a discarding stream. Lines per second, output bytes per second and
+ * number of memory allocations per line are printed in the CSV (default)
+ * or JSON format so they can be compared between versions.
+ *
+ * Usage: typograph_bench [--size N] [--depth N] [--min-time SECONDS]
+ *                        [--format csv|json]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <ondrart/typograph/linedriverios.h>
+#include <ondrart/typograph/linedriverpre.h>
+#include <ondrart/typograph/typograph.h>
+#include <ondrart/typograph/typographblockattrs.h>
+#include <ondrart/typograph/typographblockbox.h>
+#include <ondrart/typograph/typographblockcols.h>
+#include <ondrart/typograph/typographblockholder.h>
+#include <ondrart/typograph/typographblockpar.h>
+#include <ondrart/typograph/typographblockseq.h>
+#include <ondrart/typograph/typographblocktext.h>
+
+namespace T = ::OndraRT::Typograph;
+
+/* -- counting of the memory allocations */
+namespace {
+
+std::atomic<std::size_t> allocations(0);
+
+} /* -- namespace */
+
+void* operator new(
+    std::size_t size_) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if(void* ptr_ = std::malloc(size_ > 0 ? size_ : 1))
+    return ptr_;
+  throw std::bad_alloc();
+}
+
+void operator delete(
+    void* ptr_) noexcept {
+  std::free(ptr_);
+}
+
+void operator delete(
+    void* ptr_,
+    std::size_t) noexcept {
+  std::free(ptr_);
+}
+
+namespace {
+
+enum Driver {
+  DRIVER_IOS = 0,
+  DRIVER_PRE,
+};
+
+const char* const DRIVER_NAMES[] = {"ios", "pre"};
+
+const char LOREM_STYLED[] =
+    "#bg:blue#Lorem *ipsum* **dolor** sit amet, consectetuer adipiscing elit. Nulla est. Lorem "
+    "ipsum dolor #fg:red#sit amet, consectetuer adipiscing elit. Ut enim ad minim veniam, "
+    "quis nos*trud exe**rcitation* ullamco** laboris nisi ut aliquip ex ea commodo "
+    "consequat. Integer pellentesque quam vel velit. Etiam dui sem, fermentum "
+    "vitae, sa#fg:cyan#gitt#fg#is id, malesuada in, quam.#bg# Itaque earum rerum hic tenetur a "
+    "sapiente delectus, ut aut reiciendis voluptatibus maiores alias consequatur "
+    "aut perferendis doloribus asperiores repellat. Ut tempus purus at lorem. "
+    "Aliquam erat volutpat. Class aptent taciti sociosqu ad litora torquent per conubia nostra, per inceptos hymenaeos. Vivamus porttitor turpis ac leo. Sed vel lectus. Donec odio tempus molestie, porttitor ut, iaculis quis, sem. Nunc dapibus tortor vel mi dapibus sollicitudin. "
+    "Integer pellentesque quam vel velit. Donec ipsum massa, ullamcorper in, auctor et, scelerisque sed, est. Praesent in mauris eu tortor porttitor accumsan. Nulla est. Fusce wisi. Mauris elementum mauris vitae tortor. Suspendisse sagittis ultrices augue. Aliquam erat volutpat. Quisque tincidunt scelerisque libero. Proin in tellus sit amet nibh dignissim sagittis. In dapibus augue non sapien. Phasellus enim erat, vestibulum vel, aliquam a, posuere eu, velit. Maecenas aliquet accumsan leo. "
+    "Aliquam ante. Mauris tincidunt sem sed arcu. Integer rutrum, orci vestibulum ullamcorper ultricies, lacus quam ultricies odio, vitae placerat pede sem sit amet enim. Sed elit dui, pellentesque a, faucibus vel, interdum nec, diam. Nullam sit amet magna in magna gravida vehicula. Etiam dui sem, fermentum vitae, sagittis id, malesuada in, quam. Integer vulputate sem a nibh rutrum consequat. Pellentesque sapien. Quisque porta. Fusce consectetuer risus a nunc. Vivamus ac leo pretium faucibus. Praesent id justo in neque elementum ultrices. Nullam sit amet magna in magna gravida vehicula. Nam sed tellus id magna elementum tincidunt. Nullam dapibus fermentum ipsum. Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum. Nulla turpis magna, cursus sit amet, suscipit a, interdum id, felis.";
+
+const char LOREM_SHORT[] =
+    "Fusce tellus. In laoreet, magna id viverra tincidunt, sem odio bibendum justo, "
+    "vel imperdiet sapien wisi sed libero. Pellentesque ipsum. Phasellus et lorem "
+    "id felis nonummy placerat. Donec ipsum massa, ullamcorper in, auctor et, "
+    "scelerisque sed, est. Phasellus rhoncus. In laoreet, magna id viverra "
+    "tincidunt, sem odio bibendum justo, vel imperdiet sapien wisi sed libero. "
+    "Mauris elementum mauris vitae tortor. Aliquam erat volutpat. Nullam feugiat, "
+    "turpis at pulvinar vulputate, erat libero tristique tellus, nec bibendum odio "
+    "risus sit amet ante. Etiam ligula pede, sagittis quis, interdum ultricies, "
+    "scelerisque eu. Nam quis nulla.";
+
+const char LOREM_LONG[] =
+    "Nulla pulvinar eleifend sem. Etiam quis quam. Curabitur bibendum justo non orci. Integer tempor. Proin in tellus sit amet nibh dignissim sagittis. Integer rutrum, orci vestibulum ullamcorper ultricies, lacus quam ultricies odio, vitae placerat pede sem sit amet enim. Proin mattis lacinia justo. Suspendisse sagittis ultrices augue. Nunc dapibus tortor vel mi dapibus sollicitudin. Vivamus porttitor turpis ac leo. Nulla accumsan, elit sit amet varius semper, nulla mauris mollis quam, tempor suscipit diam nulla vel leo. Class aptent taciti sociosqu ad litora torquent per conubia nostra, per inceptos hymenaeos. Aenean id metus id velit ullamcorper pulvinar. Aenean placerat. Aliquam erat volutpat. Praesent in mauris eu tortor porttitor accumsan. Cras pede libero, dapibus nec, pretium sit amet, tempor quis.";
+
+const int COLUMNS = 50;
+const int COLUMN_WIDTH = 20;
+
+struct Options {
+  std::size_t size;
+  int depth;
+  double min_time;
+  bool json;
+};
+
+struct Result {
+  const char* scenario;
+  Driver driver;
+  std::size_t iterations;
+  std::size_t lines;
+  std::size_t bytes;
+  std::size_t allocations;
+  double seconds;
+};
+
+/**
+ * @brief Output stream buffer counting and discarding the output
+ */
+class CountingBuffer : public std::streambuf {
+  public:
+    CountingBuffer() :
+      bytes(0),
+      lines(0) {
+
+    }
+
+    std::size_t bytes;
+    std::size_t lines;
+
+  protected:
+    virtual int_type overflow(
+        int_type c_) override {
+      if(!traits_type::eq_int_type(c_, traits_type::eof())) {
+        ++bytes;
+        if(traits_type::to_char_type(c_) == '\n')
+          ++lines;
+      }
+      return traits_type::not_eof(c_);
+    }
+
+    virtual std::streamsize xsputn(
+        const char* s_,
+        std::streamsize n_) override {
+      bytes += n_;
+      lines += std::count(s_, s_ + n_, '\n');
+      return n_;
+    }
+};
+
+/**
+ * @brief One block tree of the benchmark
+ */
+struct Scenario {
+  const char* name;
+  int width;
+  T::TypographBlock* block;
+};
+
+void printHelp(
+    const char* program_) {
+  std::cerr
+      << "usage: " << program_ << " [--size N] [--depth N]"
+      << " [--min-time SECONDS] [--format csv|json]\n";
+}
+
+bool parseOptions(
+    int argc_,
+    char* argv_[],
+    Options& options_) {
+  options_.size = std::size_t(100) << 20;
+  options_.depth = 32;
+  options_.min_time = 0.2;
+  options_.json = false;
+
+  for(int i_(1); i_ < argc_; ++i_) {
+    const char* arg_(argv_[i_]);
+    if(i_ + 1 >= argc_)
+      return false;
+    const char* value_(argv_[++i_]);
+    if(std::strcmp(arg_, "--size") == 0)
+      options_.size = std::strtoull(value_, nullptr, 10);
+    else if(std::strcmp(arg_, "--depth") == 0)
+      options_.depth = std::atoi(value_);
+    else if(std::strcmp(arg_, "--min-time") == 0)
+      options_.min_time = std::strtod(value_, nullptr);
+    else if(std::strcmp(arg_, "--format") == 0 && std::strcmp(value_, "csv") == 0)
+      options_.json = false;
+    else if(std::strcmp(arg_, "--format") == 0 && std::strcmp(value_, "json") == 0)
+      options_.json = true;
+    else
+      return false;
+  }
+  return options_.size > 0 && options_.depth >= 0;
+}
+
+/**
+ * @brief Repeat the lorem ipsum paragraphs up to the requested size
+ */
+std::string makeBody(
+    std::size_t size_) {
+  const char* const paragraphs_[] = {LOREM_STYLED, LOREM_SHORT, LOREM_LONG};
+  std::string body_;
+  body_.reserve(size_ + sizeof(LOREM_STYLED));
+  for(int i_(0); body_.size() < size_; i_ = (i_ + 1) % 3) {
+    if(!body_.empty())
+      body_ += ' ';
+    body_ += paragraphs_[i_];
+  }
+  return body_;
+}
+
+/**
+ * @brief The example tree of the typograph (a paragraph and a box
+ *     in two columns)
+ *
+ * @param holder_ Holder of the blocks
+ * @param seq_blocks_ Array of two items for the sequence block. The sequence
+ *     block doesn't copy the array.
+ */
+T::TypographBlock* createExample(
+    T::TypographBlockHolder& holder_,
+    T::TypographBlock** seq_blocks_) {
+  auto* block1_(holder_.createText(LOREM_STYLED));
+  auto* par1_(holder_.createBlock<T::TypographBlockPar>(block1_, 2, 0));
+  auto* box1_(holder_.createBlock<T::TypographBlockBox>(par1_, 0, 0, 0, 0));
+  auto* attrs1_(holder_.createBlock<T::TypographBlockAttrs>(
+      box1_,
+      T::LineDriver::FS_DEFAULT,
+      T::LineDriver::FW_DEFAULT,
+      T::LineDriver::C_DEFAULT,
+      T::LineDriver::C_CYAN));
+
+  auto* block2_(holder_.createText(LOREM_SHORT));
+  auto* par2_(holder_.createBlock<T::TypographBlockPar>(block2_, 0, 2));
+  auto* box2_(holder_.createBlock<T::TypographBlockBox>(par2_, 0, 0, 0, 0));
+
+  seq_blocks_[0] = attrs1_;
+  seq_blocks_[1] = box2_;
+  auto* seq1_(holder_.createBlock<T::TypographBlockSeq>(seq_blocks_, 2));
+
+  auto* block3_(holder_.createText(LOREM_LONG));
+  auto* par3_(holder_.createBlock<T::TypographBlockPar>(block3_, 4, 0));
+  auto* box3_(holder_.createBlock<T::TypographBlockBox>(par3_, 2, 0, 2, 0));
+  auto* box4_(holder_.createBlock<T::TypographBlockBox>(box3_, 0));
+  box4_->setPadding(5);
+
+  const T::TypographBlockCols::Column cols_[2] = {
+      {seq1_, -1},
+      {box4_, -1},
+  };
+  auto* tcols_(holder_.createBlock<T::TypographBlockCols>(cols_, 2));
+  return holder_.createBlock<T::TypographBlockAttrs>(
+      tcols_,
+      T::LineDriver::FS_DEFAULT,
+      T::LineDriver::FW_DEFAULT,
+      T::LineDriver::C_DEFAULT,
+      T::LineDriver::C_YELLOW);
+}
+
+/**
+ * @brief Deep nesting of boxes and attributes around one paragraph
+ */
+T::TypographBlock* createNested(
+    T::TypographBlockHolder& holder_,
+    const std::string& body_,
+    int depth_) {
+  T::TypographBlock* block_(holder_.createBlock<T::TypographBlockPar>(
+      holder_.createText(body_), 2, 0));
+  for(int i_(0); i_ < depth_; ++i_) {
+    auto* box_(holder_.createBlock<T::TypographBlockBox>(block_, 0));
+    box_->setPadding(1, 0, 0, 0);
+    block_ = holder_.createBlock<T::TypographBlockAttrs>(
+        box_,
+        (i_ % 2) ? T::LineDriver::FS_ITALIC : T::LineDriver::FS_DEFAULT,
+        (i_ % 3) ? T::LineDriver::FW_DEFAULT : T::LineDriver::FW_BOLD,
+        static_cast<T::LineDriver::Color>(i_ % 8),
+        T::LineDriver::C_DEFAULT);
+  }
+  return block_;
+}
+
+/**
+ * @brief A table of many narrow columns
+ */
+T::TypographBlock* createColumns(
+    T::TypographBlockHolder& holder_,
+    const std::string& body_,
+    bool concurrent_) {
+  std::vector<T::TypographBlockCols::Column> cols_;
+  for(int i_(0); i_ < COLUMNS; ++i_) {
+    auto* par_(holder_.createBlock<T::TypographBlockPar>(
+        holder_.createText(body_), 0, 0));
+    auto* box_(holder_.createBlock<T::TypographBlockBox>(
+        par_, (i_ > 0) ? 1 : 0, 0, 0, 0));
+    cols_.push_back({box_, -1});
+  }
+  auto* table_(holder_.createBlock<T::TypographBlockCols>(
+      cols_.data(), static_cast<int>(cols_.size())));
+  table_->setConcurrent(concurrent_);
+  return table_;
+}
+
+Result measure(
+    const Scenario& scenario_,
+    Driver driver_,
+    const Options& options_) {
+  typedef std::chrono::steady_clock Clock;
+
+  CountingBuffer buffer_;
+  std::ostream sink_(&buffer_);
+
+  Result result_{scenario_.name, driver_, 0, 0, 0, 0, 0.0};
+  const std::size_t allocations_(allocations.load(std::memory_order_relaxed));
+  const Clock::time_point start_(Clock::now());
+  do {
+    scenario_.block->reset();
+    if(driver_ == DRIVER_IOS) {
+      T::LineDriverIos driver_ios_(&sink_);
+      T::Typograph typo_(&driver_ios_, scenario_.width);
+      typo_.writeBlock(*scenario_.block);
+    }
+    else {
+      T::LineDriverPre driver_pre_(&sink_);
+      T::Typograph typo_(&driver_pre_, scenario_.width);
+      typo_.writeBlock(*scenario_.block);
+    }
+    ++result_.iterations;
+    result_.seconds = std::chrono::duration<double>(Clock::now() - start_).count();
+  } while(result_.seconds < options_.min_time);
+  result_.allocations =
+      allocations.load(std::memory_order_relaxed) - allocations_;
+  result_.lines = buffer_.lines;
+  result_.bytes = buffer_.bytes;
+
+  return result_;
+}
+
+double linesPerSecond(
+    const Result& result_) {
+  return static_cast<double>(result_.lines) / result_.seconds;
+}
+
+double bytesPerSecond(
+    const Result& result_) {
+  return static_cast<double>(result_.bytes) / result_.seconds;
+}
+
+double allocationsPerLine(
+    const Result& result_) {
+  if(result_.lines == 0)
+    return 0.0;
+  return static_cast<double>(result_.allocations) / result_.lines;
+}
+
+void printCsvHeader() {
+  std::cout
+      << "scenario,driver,iterations,lines,bytes,seconds,"
+         "lines_per_s,bytes_per_s,allocs_per_line"
+      << std::endl;
+}
+
+void printCsv(
+    const Result& result_) {
+  std::cout
+      << result_.scenario << ','
+      << DRIVER_NAMES[result_.driver] << ','
+      << result_.iterations << ','
+      << result_.lines << ','
+      << result_.bytes << ','
+      << result_.seconds << ','
+      << linesPerSecond(result_) << ','
+      << bytesPerSecond(result_) << ','
+      << allocationsPerLine(result_) << std::endl;
+}
+
+void printJson(
+    const Result& result_,
+    bool first_) {
+  std::cout
+      << (first_ ? "[\n" : ",\n")
+      << "  {\"scenario\": \"" << result_.scenario << '"'
+      << ", \"driver\": \"" << DRIVER_NAMES[result_.driver] << '"'
+      << ", \"iterations\": " << result_.iterations
+      << ", \"lines\": " << result_.lines
+      << ", \"bytes\": " << result_.bytes
+      << ", \"seconds\": " << result_.seconds
+      << ", \"lines_per_s\": " << linesPerSecond(result_)
+      << ", \"bytes_per_s\": " << bytesPerSecond(result_)
+      << ", \"allocs_per_line\": " << allocationsPerLine(result_)
+      << '}' << std::flush;
+}
+
+} /* -- namespace */
+
+int main(
+    int argc_,
+    char* argv_[]) {
+  Options options_;
+  if(!parseOptions(argc_, argv_, options_)) {
+    printHelp(argv_[0]);
+    return 1;
+  }
+
+  /* -- The trees are built once, only their rendering is measured. The
+   *    long paragraph gets the whole size, the columns share it. The nested
+   *    tree gets a fraction of the size as every its line passes all
+   *    the levels. */
+  T::TypographBlockHolder holder_;
+  T::TypographBlock* example_seq_[2];
+  const Scenario scenarios_[] = {
+      {"example", 80, createExample(holder_, example_seq_)},
+      {"nested", 2 * options_.depth + 80,
+          createNested(holder_, makeBody(options_.size / 100), options_.depth)},
+      {"columns", COLUMNS * COLUMN_WIDTH,
+          createColumns(holder_, makeBody(options_.size / COLUMNS), false)},
+      {"columns_concurrent", COLUMNS * COLUMN_WIDTH,
+          createColumns(holder_, makeBody(options_.size / COLUMNS), true)},
+      {"text", 80, holder_.createBlock<T::TypographBlockPar>(
+          holder_.createText(makeBody(options_.size)), 2, 0)},
+  };
+
+  bool first_(true);
+  if(!options_.json)
+    printCsvHeader();
+  for(const Scenario& scenario_ : scenarios_) {
+    for(Driver driver_ : {DRIVER_IOS, DRIVER_PRE}) {
+      const Result result_(measure(scenario_, driver_, options_));
+      if(options_.json)
+        printJson(result_, first_);
+      else
+        printCsv(result_);
+      first_ = false;
+    }
+  }
+  if(options_.json)
+    std::cout << (first_ ? "[]\n" : "\n]\n") << std::flush;
+
+  return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__ONDRART_BASE64_ALPHABET_H_
+#define OndraRT__ONDRART_BASE64_ALPHABET_H_
+
+namespace OndraRT {
+
+namespace Base64 {
+
+/*
+ * The alphabet policies describe variants of the base64 encoding. All
+ * variants share the letters and the digits (values 0 - 61), a policy
+ * specifies:
+ *   - char62() and char63() - characters of the values 62 and 63,
+ *   - padding() - whether the incomplete triplets are padded by '=',
+ *   - crlf() - whether the lines are broken by CRLF instead of LF,
+ *   - lineLength() - default length of the encoded lines.
+ *
+ * The encoders, the decoders and the streams are instantiated for the
+ * policies defined in this file.
+ */
+
+/**
+ * @brief The standard base64 alphabet (RFC 4648, section 4)
+ */
+struct AlphabetStandard {
+    static constexpr char char62() { return '+'; }
+    static constexpr char char63() { return '/'; }
+    static constexpr bool padding() { return true; }
+    static constexpr bool crlf() { return false; }
+    static constexpr int lineLength() { return -1; }
+};
+
+/**
+ * @brief URL and filename safe alphabet (RFC 4648, section 5)
+ */
+struct AlphabetUrl {
+    static constexpr char char62() { return '-'; }
+    static constexpr char char63() { return '_'; }
+    static constexpr bool padding() { return true; }
+    static constexpr bool crlf() { return false; }
+    static constexpr int lineLength() { return -1; }
+};
+
+/**
+ * @brief MIME content transfer encoding (RFC 2045, section 6.8)
+ *
+ * The standard alphabet broken into lines of 76 characters terminated
+ * by CRLF.
+ */
+struct AlphabetMime {
+    static constexpr char char62() { return '+'; }
+    static constexpr char char63() { return '/'; }
+    static constexpr bool padding() { return true; }
+    static constexpr bool crlf() { return true; }
+    static constexpr int lineLength() { return 76; }
+};
+
+/**
+ * @brief A variant of an alphabet without the padding
+ */
+template<typename Alphabet_>
+struct AlphabetNoPadding : public Alphabet_ {
+    static constexpr bool padding() { return false; }
+};
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__ONDRART_BASE64_ALPHABET_H_ */
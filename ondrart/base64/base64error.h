@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__ONDRART_BASE64_BASE64ERROR_H_
+#define OndraRT__ONDRART_BASE64_BASE64ERROR_H_
+
+#include <string>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+class Base64Error {
+  public:
+    explicit Base64Error(
+        const std::string& message_);
+    Base64Error(
+        Base64Error&&);
+    ~Base64Error();
+
+    /* -- avoid copying */
+    Base64Error(
+        const Base64Error&) = delete;
+    Base64Error& operator =(
+        const Base64Error&) = delete;
+
+  public:
+    std::string message;
+};
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__ONDRART_BASE64_BASE64ERROR_H_ */
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__ONDRART_BASE64_CODEC_H_
+#define OndraRT__ONDRART_BASE64_CODEC_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <ondrart/base64/alphabet.h>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+/**
+ * @brief Incremental base64 encoder working on caller's buffers
+ *
+ * The encoder keeps just the position in current line, hence the data
+ * can be encoded in several pieces. All pieces but the last one must
+ * contain whole triplets.
+ *
+ * @tparam Alphabet_ The alphabet policy (see alphabet.h)
+ */
+template<typename Alphabet_>
+class BasicEncoder {
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param line_length_ Length of one base64 encoded line. If the value
+     *     is negative, the output is not broken into lines. The value
+     *     is rounded to the closest lesser multiplication of 4.
+     */
+    explicit BasicEncoder(
+        int line_length_ = Alphabet_::lineLength()) noexcept;
+
+    /**
+     * @brief Get exact length of the encoded piece
+     *
+     * @param length_ Length of the input piece in bytes
+     * @return Number of characters written by the encode() method
+     */
+    std::size_t getLength(
+        std::size_t length_) const noexcept;
+
+    /**
+     * @brief Encode a piece of data
+     *
+     * @param input_ The input bytes
+     * @param length_ Number of the input bytes. If the value is not
+     *     a multiplication of 3, the last triplet is padded (if the alphabet
+     *     uses the padding).
+     * @param output_ Output buffer
+     * @param capacity_ Size of the output buffer. Base64Error is thrown
+     *     if it's less than getLength(length_).
+     * @return Number of written characters
+     */
+    std::size_t encode(
+        const void* input_,
+        std::size_t length_,
+        char* output_,
+        std::size_t capacity_);
+
+    /**
+     * @brief Move the line position as if a piece of data was encoded
+     *
+     * The method allows to encode pieces of one stream by several encoders
+     * independently. An encoder of a piece is a copy of the encoder
+     * of the previous pieces advanced by their lengths.
+     *
+     * @param length_ Length of the skipped piece in bytes. It must be
+     *     a multiplication of 3.
+     */
+    void advance(
+        std::size_t length_) noexcept;
+
+  private:
+    void breakLine(
+        char*& output_);
+
+    int len_quat;
+    int quaternions;
+};
+
+/**
+ * @brief Incremental base64 decoder working on caller's buffers
+ *
+ * The decoder skips whitespaces and it validates the padding. The data
+ * may be split into pieces arbitrarily, a quaternion broken by the piece
+ * boundary is kept inside the decoder.
+ *
+ * @tparam Alphabet_ The alphabet policy (see alphabet.h). If the alphabet
+ *     doesn't use the padding, the padding character is not accepted and
+ *     the last quaternion may be incomplete.
+ */
+template<typename Alphabet_>
+class BasicDecoder {
+  public:
+    /**
+     * @brief Ctor
+     */
+    BasicDecoder() noexcept;
+
+    /**
+     * @brief Decode a piece of data
+     *
+     * @param input_ The input characters
+     * @param length_ Number of the input characters
+     * @param output_ Output buffer
+     * @param capacity_ Size of the output buffer. The maxDecodedLength()
+     *     is always enough.
+     * @return Number of decoded bytes
+     * @exception Base64Error if the input is not valid or if the output
+     *     buffer is too small
+     */
+    std::size_t decode(
+        const char* input_,
+        std::size_t length_,
+        void* output_,
+        std::size_t capacity_);
+
+    /**
+     * @brief Finish the decoded data
+     *
+     * The method checks that the data are not truncated and it resets
+     * the decoder for next data.
+     *
+     * @exception Base64Error if the data are truncated
+     */
+    void finish();
+
+  private:
+    std::uint8_t* decodeChar(
+        char c_,
+        std::uint8_t* output_,
+        std::uint8_t* end_);
+
+    std::uint8_t pending[3];
+    int pending_count;
+    int padding;
+    bool terminated;
+};
+
+typedef BasicEncoder<AlphabetStandard> Encoder;
+typedef BasicDecoder<AlphabetStandard> Decoder;
+
+/**
+ * @brief Get exact length of encoded data
+ *
+ * @param length_ Length of the input data in bytes
+ * @param line_length_ Length of encoded lines (see the Encoder)
+ */
+template<typename Alphabet_ = AlphabetStandard>
+std::size_t encodedLength(
+    std::size_t length_,
+    int line_length_ = Alphabet_::lineLength()) noexcept;
+
+/**
+ * @brief Encode a buffer
+ *
+ * @param input_ The input bytes
+ * @param length_ Number of the input bytes
+ * @param output_ Output buffer
+ * @param capacity_ Size of the output buffer. It must not be less than
+ *     the encodedLength().
+ * @param line_length_ Length of encoded lines (see the Encoder)
+ * @return Number of written characters
+ * @exception Base64Error if the output buffer is too small
+ */
+template<typename Alphabet_ = AlphabetStandard>
+std::size_t encode(
+    const void* input_,
+    std::size_t length_,
+    char* output_,
+    std::size_t capacity_,
+    int line_length_ = Alphabet_::lineLength());
+
+/**
+ * @brief Get upper bound of length of decoded data
+ *
+ * @param length_ Number of the encoded characters
+ */
+std::size_t maxDecodedLength(
+    std::size_t length_) noexcept;
+
+/**
+ * @brief Get exact length of decoded data
+ *
+ * The encoded data are scanned, the whitespaces and the padding are
+ * not counted. The value is exact for valid data only. The function
+ * works for all alphabets.
+ *
+ * @param input_ The encoded characters
+ * @param length_ Number of the encoded characters
+ */
+std::size_t decodedLength(
+    const char* input_,
+    std::size_t length_) noexcept;
+
+/**
+ * @brief Decode a buffer
+ *
+ * @param input_ The encoded characters
+ * @param length_ Number of the encoded characters
+ * @param output_ Output buffer
+ * @param capacity_ Size of the output buffer. The decodedLength() is enough.
+ * @return Number of decoded bytes
+ * @exception Base64Error if the input is not valid or if the output buffer
+ *     is too small
+ */
+template<typename Alphabet_ = AlphabetStandard>
+std::size_t decode(
+    const char* input_,
+    std::size_t length_,
+    void* output_,
+    std::size_t capacity_);
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__ONDRART_BASE64_CODEC_H_ */
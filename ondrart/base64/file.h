@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__ONDRART_BASE64_FILE_H_
+#define OndraRT__ONDRART_BASE64_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+#include <ondrart/base64/alphabet.h>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+/**
+ * @brief Encode a whole file
+ *
+ * The input file is mapped into memory and it's encoded directly into
+ * the mapped output file. The output file is created (or truncated)
+ * with the exact length of the encoded data. An existing output file
+ * must be a regular file. If the encoding fails, the output file is
+ * removed if it has been created by the call.
+ *
+ * @param input_ Path of the input file
+ * @param output_ Path of the output file
+ * @param line_length_ Length of encoded lines (see the Encoder)
+ * @return Length of the output file
+ * @exception Base64Error if a file cannot be opened, mapped or written
+ *     or if both paths refer to the same file or the output is not
+ *     a regular file
+ */
+template<typename Alphabet_ = AlphabetStandard>
+std::size_t encodeFile(
+    const std::string& input_,
+    const std::string& output_,
+    int line_length_ = Alphabet_::lineLength());
+
+/**
+ * @brief Decode a whole file
+ *
+ * The input file is mapped into memory and it's decoded directly into
+ * the mapped output file. The output file is created (or truncated)
+ * with the exact length of the decoded data. An existing output file
+ * must be a regular file. If the decoding fails, the output file is
+ * removed if it has been created by the call.
+ *
+ * @param input_ Path of the input file
+ * @param output_ Path of the output file
+ * @return Length of the output file
+ * @exception Base64Error if a file cannot be opened, mapped or written,
+ *     if both paths refer to the same file, if the output is not
+ *     a regular file or if the input is not valid
+ */
+template<typename Alphabet_ = AlphabetStandard>
+std::size_t decodeFile(
+    const std::string& input_,
+    const std::string& output_);
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__ONDRART_BASE64_FILE_H_ */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__ONDRART_BASE64_ISTREAM_H_
+#define OndraRT__ONDRART_BASE64_ISTREAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <ondrart/base64/codec.h>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+/**
+ * @brief Stream buffer decoding base64 data read from a source stream
+ *
+ * The source is read and decoded in large blocks, the memory consumption
+ * doesn't depend on the size of the decoded data. Whitespaces (including
+ * the line breaks) are skipped. The padding is validated: the encoded data
+ * must be terminated by a complete (possibly padded) quaternion and nothing
+ * but whitespaces can follow the padding.
+ *
+ * Invalid input is reported by the Base64Error exception thrown from
+ * the underflow() method. If the buffer is used by the IStream, the stream
+ * sets its badbit (and rethrows the exception if it's asked by the stream's
+ * exception mask).
+ *
+ * @tparam Alphabet_ The alphabet policy (see alphabet.h)
+ */
+template<typename Alphabet_>
+class BasicIStreamBuffer final : public std::streambuf {
+  private:
+    std::istream* source;
+
+    enum {
+      RAW_SIZE = 4 * 16384,  /**< size of a block read from the source */
+      BUFFER_SIZE = RAW_SIZE / 4 * 3 + 3,  /**< decoded block, see
+                                                maxDecodedLength() */
+    };
+    std::vector<char> raw;
+    std::vector<char_type> buffer;
+    BasicDecoder<Alphabet_> decoder;
+
+    /* -- streambuf interface */
+    virtual int_type underflow() override;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param source_ The decorated input stream. The ownership is not taken.
+     */
+    explicit BasicIStreamBuffer(
+        std::istream* source_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~BasicIStreamBuffer();
+
+    /* -- avoid copying */
+    BasicIStreamBuffer(
+        const BasicIStreamBuffer&) = delete;
+    BasicIStreamBuffer& operator =(
+        const BasicIStreamBuffer&) = delete;
+};
+
+/**
+ * @brief Base64 input stream
+ *
+ * @tparam Alphabet_ The alphabet policy (see alphabet.h)
+ */
+template<typename Alphabet_>
+class BasicIStream : public std::istream {
+  private:
+    BasicIStreamBuffer<Alphabet_> buffer;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param source_ A decorated input stream. The ownership is not taken.
+     */
+    explicit BasicIStream(
+        std::istream* source_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~BasicIStream();
+};
+
+typedef BasicIStreamBuffer<AlphabetStandard> IStreamBuffer;
+typedef BasicIStream<AlphabetStandard> IStream;
+typedef BasicIStream<AlphabetNoPadding<AlphabetStandard>> IStreamNoPadding;
+typedef BasicIStream<AlphabetUrl> IStreamUrl;
+typedef BasicIStream<AlphabetNoPadding<AlphabetUrl>> IStreamUrlNoPadding;
+typedef BasicIStream<AlphabetMime> IStreamMime;
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__ONDRART_BASE64_ISTREAM_H_ */
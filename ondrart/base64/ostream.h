@@ -20,42 +20,112 @@
 #ifndef OndraRT__ONDRART_BASE64_OSTREAM_H_
 #define OndraRT__ONDRART_BASE64_OSTREAM_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <memory>
+#include <vector>
+
+#include <ondrart/base64/codec.h>
+#include <ondrart/base64/sink.h>
 
 namespace OndraRT {
 
 namespace Base64 {
 
-class OStreamBuffer final : public std::streambuf {
-  private:
-    std::ostream* sink;
-    const int len_quat;
-    int quaternions;
-
-    enum { BUFFER_SIZE = 3 };
-    char_type buffer[BUFFER_SIZE];
+class Workers;
 
-    void pushTriplet(
-        const std::uint8_t* ibuff_,
-        const std::uint8_t* current_);
+/**
+ * @brief Stream buffer encoding written bytes into the base64
+ *
+ * The buffer collects the input bytes in a large internal buffer and
+ * encodes them block by block. Hence, the encoded data reaches the sink
+ * when the buffer is full, when the stream is flushed (only complete
+ * triplets are encoded) or when the stream is finished.
+ *
+ * In the parallel mode the buffer is larger and a full block is split
+ * into pieces of whole triplets. The pieces are encoded by a pool of
+ * threads and they are written into the sink in the original order.
+ * The output is the same as in the serial mode.
+ *
+ * The encoded blocks (including the line breaks) are passed to the sink
+ * at once. A sink writing into a file descriptor or passing the data
+ * to a callback avoids the overhead of the standard streams. Errors
+ * of the sink are reported by the finish() method, the destructor
+ * ignores them.
+ *
+ * @tparam Alphabet_ The alphabet policy (see alphabet.h)
+ */
+template<typename Alphabet_>
+class BasicOStreamBuffer final : public std::streambuf {
+  private:
+    std::unique_ptr<Sink> stream_sink;
+    Sink* sink;
+    BasicEncoder<Alphabet_> encoder;
+    std::unique_ptr<Workers> workers;
+
+    enum {
+      BLOCK_SIZE = 3 * 16384,  /**< size of a block per one thread, it
+                                    must be a multiple of 3 */
+      PIECE_SIZE = 3 * 262144,  /**< size of a piece encoded by one thread
+                                     in the parallel mode */
+    };
+    std::size_t buffer_size;
+    std::vector<char_type> buffer;
+    std::vector<char> output;
+
+    void encodeParallel(
+        const std::uint8_t* input_,
+        std::size_t length_);
+    void encodeBlock(
+        const std::uint8_t* input_,
+        std::size_t length_);
+    void encodePending();
 
     /* -- streambuf interface */
     virtual int_type overflow(
         int_type ch) override;
+    virtual std::streamsize xsputn(
+        const char_type* s,
+        std::streamsize n) override;
+    virtual int sync() override;
 
   public:
-    explicit OStreamBuffer(
+    /**
+     * @brief Ctor
+     *
+     * @param sink_ A decorated output stream. The ownership is not taken.
+     * @param quaternions_ Number of quaternions in one line. If the value
+     *     is not positive, the output is not broken into lines.
+     * @param threads_ Number of encoding threads. The value 1 means
+     *     the serial encoding, zero or a negative value means the number
+     *     of the CPU cores.
+     */
+    explicit BasicOStreamBuffer(
         std::ostream* sink_,
-        int quaternions_);
+        int quaternions_,
+        int threads_ = 1);
 
-    virtual ~OStreamBuffer();
+    /**
+     * @brief Ctor
+     *
+     * @param sink_ The sink of the encoded data. The ownership is not taken.
+     * @param quaternions_ Number of quaternions in one line. If the value
+     *     is not positive, the output is not broken into lines.
+     * @param threads_ Number of encoding threads (see the previous ctor)
+     */
+    explicit BasicOStreamBuffer(
+        Sink* sink_,
+        int quaternions_,
+        int threads_ = 1);
+
+    virtual ~BasicOStreamBuffer();
 
     /* -- avoid copying */
-    OStreamBuffer(
-        const OStreamBuffer&) = delete;
-    OStreamBuffer& operator =(
-        const OStreamBuffer&) = delete;
+    BasicOStreamBuffer(
+        const BasicOStreamBuffer&) = delete;
+    BasicOStreamBuffer& operator =(
+        const BasicOStreamBuffer&) = delete;
 
     /**
      * @brief Finish current stream - flush last bytes and fill the padding
@@ -65,10 +135,13 @@ class OStreamBuffer final : public std::streambuf {
 
 /**
  * @brief Base64 output stream
+ *
+ * @tparam Alphabet_ The alphabet policy (see alphabet.h)
  */
-class OStream : public std::ostream {
+template<typename Alphabet_>
+class BasicOStream : public std::ostream {
   private:
-    OStreamBuffer buffer;
+    BasicOStreamBuffer<Alphabet_> buffer;
 
   public:
     /**
@@ -78,15 +151,34 @@ class OStream : public std::ostream {
      * @param line_length_ Length of one base64 encoded line. If the value
      *     is negative, the output is not broken into lines. The value
      *     is rounded to the closest lesser multiplication of 4.
+     * @param threads_ Number of encoding threads. The value 1 means
+     *     the serial encoding, zero or a negative value means the number
+     *     of the CPU cores. The parallel mode pays off for large amounts
+     *     of data written in large blocks.
      */
-    explicit OStream(
+    explicit BasicOStream(
         std::ostream* sink_,
-        int line_length_ = -1);
+        int line_length_ = Alphabet_::lineLength(),
+        int threads_ = 1);
+
+    /**
+     * @brief Ctor
+     *
+     * @param sink_ The sink of the encoded data (e.g. SinkFd). The ownership
+     *     is not taken.
+     * @param line_length_ Length of one base64 encoded line (see
+     *     the previous ctor)
+     * @param threads_ Number of encoding threads (see the previous ctor)
+     */
+    explicit BasicOStream(
+        Sink* sink_,
+        int line_length_ = Alphabet_::lineLength(),
+        int threads_ = 1);
 
     /**
      * @brief Dtor
      */
-    virtual ~OStream();
+    virtual ~BasicOStream();
 
     /**
      * @brief Finish current stream - flush last bytes and fill the padding
@@ -94,6 +186,13 @@ class OStream : public std::ostream {
     void finish();
 };
 
+typedef BasicOStreamBuffer<AlphabetStandard> OStreamBuffer;
+typedef BasicOStream<AlphabetStandard> OStream;
+typedef BasicOStream<AlphabetNoPadding<AlphabetStandard>> OStreamNoPadding;
+typedef BasicOStream<AlphabetUrl> OStreamUrl;
+typedef BasicOStream<AlphabetNoPadding<AlphabetUrl>> OStreamUrlNoPadding;
+typedef BasicOStream<AlphabetMime> OStreamMime;
+
 } /* -- namespace Base64 */
 
 } /* -- namespace OndraRT */
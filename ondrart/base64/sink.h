@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__ONDRART_BASE64_SINK_H_
+#define OndraRT__ONDRART_BASE64_SINK_H_
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+
+namespace OndraRT {
+
+namespace Base64 {
+
+/**
+ * @brief Generic target of the encoded data
+ *
+ * The base64 output stream passes the encoded data to the sink in large
+ * blocks. The line breaks are already part of the blocks.
+ */
+class Sink {
+  public:
+    /**
+     * @brief Ctor
+     */
+    Sink();
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~Sink();
+
+    /* -- avoid copying */
+    Sink(
+        const Sink&) = delete;
+    Sink& operator =(
+        const Sink&) = delete;
+
+    /**
+     * @brief Write a block of encoded data
+     *
+     * @param data_ The data
+     * @param length_ Length of the data
+     * @exception Base64Error if the data cannot be written
+     */
+    virtual void write(
+        const char* data_,
+        std::size_t length_) = 0;
+
+    /**
+     * @brief Flush the written data
+     *
+     * The default implementation does nothing.
+     */
+    virtual void flush();
+};
+
+/**
+ * @brief Sink writing into an output stream
+ */
+class SinkOStream : public Sink {
+  private:
+    std::ostream* os;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param os_ The output stream. The ownership is not taken.
+     */
+    explicit SinkOStream(
+        std::ostream* os_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~SinkOStream();
+
+    virtual void write(
+        const char* data_,
+        std::size_t length_) override;
+    virtual void flush() override;
+};
+
+/**
+ * @brief Sink writing into a file descriptor
+ *
+ * The data are written by the write() system call directly. Interrupted
+ * and partial writes are repeated.
+ */
+class SinkFd : public Sink {
+  private:
+    int fd;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param fd_ The file descriptor. The ownership is not taken.
+     */
+    explicit SinkFd(
+        int fd_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~SinkFd();
+
+    virtual void write(
+        const char* data_,
+        std::size_t length_) override;
+};
+
+/**
+ * @brief Sink passing the data to a callback
+ */
+class SinkCallback : public Sink {
+  public:
+    typedef std::function<void(const char*, std::size_t)> Callback;
+
+  private:
+    Callback callback;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param callback_ The callback. It's invoked with each block
+     *     of the encoded data.
+     */
+    explicit SinkCallback(
+        Callback callback_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~SinkCallback();
+
+    virtual void write(
+        const char* data_,
+        std::size_t length_) override;
+};
+
+} /* -- namespace Base64 */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__ONDRART_BASE64_SINK_H_ */
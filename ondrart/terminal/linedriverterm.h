@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__LINEDRIVERTERM_H_
+#define OndraRT__LINEDRIVERTERM_H_
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#include <ondrart/typograph/linedriver.h>
+
+namespace OndraRT {
+
+namespace Terminal {
+
+/**
+ * @brief A line driver generating output for ANSI (VT100 compatible)
+ *     terminals
+ *
+ * The text attributes are rendered by the SGR escape sequences. The driver
+ * tracks the attributes set in the terminal and the requested ones.
+ * The requested attributes are applied lazily just before some characters
+ * are written. Then all differences are combined into one escape sequence,
+ * hence the attributes toggled back and forth don't emit anything.
+ * Skipped characters without a background color are postponed, so
+ * the trailing spaces of the lines are not written at all.
+ *
+ * The output is collected in an internal buffer which is written into
+ * the stream when it's full, when the flush() method is invoked or when
+ * the driver is destroyed.
+ */
+class LineDriverTerm : public Typograph::LineDriver {
+  public:
+    /**
+     * @brief Text attributes of the terminal
+     */
+    struct Attributes {
+      bool italic;
+      bool bold;
+      Color foreground;
+      Color background;
+
+      bool operator ==(
+          const Attributes& other_) const noexcept;
+      bool operator !=(
+          const Attributes& other_) const noexcept;
+    };
+
+    /**
+     * @brief Ctor
+     *
+     * @param os_ The output stream. The ownership is not taken.
+     * @param buffer_size_ Size of the output buffer
+     */
+    explicit LineDriverTerm(
+        std::ostream* os_,
+        std::size_t buffer_size_ = 65536);
+
+    /**
+     * @brief Dtor
+     *
+     * The terminal attributes are reset and the buffer is flushed.
+     */
+    virtual ~LineDriverTerm();
+
+    /* -- avoid copying */
+    LineDriverTerm(
+        const LineDriverTerm&) = delete;
+    LineDriverTerm& operator =(
+        const LineDriverTerm&) = delete;
+
+    /**
+     * @brief Write the buffered output into the stream and flush it
+     */
+    void flush();
+
+    /* -- line driver */
+    virtual void skipChars(
+        int chars_) override;
+    virtual void writeText(
+        const char* text_,
+        int length_) override;
+    virtual void breakLine() override;
+    virtual void finishLine(
+        int chars_) override;
+    virtual void writeStyledLine(
+        const char* text_,
+        int length_,
+        const StyleRun* runs_,
+        int runs_count_) override;
+    virtual void setFontStyle(
+        FontStyle style_) override;
+    virtual void setFontWeight(
+        FontWeight weight_) override;
+    virtual void setForegroundColor(
+        Color color_) override;
+    virtual void setBackgroundColor(
+        Color color_) override;
+
+  private:
+    void applyAttributes(
+        const Attributes& attributes_);
+    void writeSpaces();
+    void syncAttributes();
+    void append(
+        const char* text_,
+        std::size_t length_);
+    void appendFill(
+        char fill_,
+        int chars_);
+    void appendBreak();
+    void writeBuffer();
+
+    std::ostream* os;
+    std::size_t buffer_size;
+    std::string buffer;
+    Attributes terminal;
+    Attributes requested;
+    int spaces;
+};
+
+} /* -- namespace Terminal */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__LINEDRIVERTERM_H_ */
@@ -55,6 +55,22 @@ class LineDriver {
       C_WHITE,
     };
 
+    /**
+     * @brief A run of characters sharing the same attributes
+     *
+     * A skipped run stands for skipChars(). Its text consists of spaces,
+     * so drivers not distinguishing the skips can write it as any
+     * other text.
+     */
+    struct StyleRun {
+      int length;
+      FontStyle font_style;
+      FontWeight font_weight;
+      Color foreground;
+      Color background;
+      bool skipped;
+    };
+
   public:
     /**
      * @brief Ctor
@@ -95,6 +111,34 @@ class LineDriver {
      */
     virtual void breakLine() = 0;
 
+    /**
+     * @brief Skip rest of current line and finish it
+     *
+     * The default implementation skips the characters and breaks the line.
+     *
+     * @param chars_ Number of skipped characters
+     */
+    virtual void finishLine(
+        int chars_);
+
+    /**
+     * @brief Write a whole line composed of runs of styled text
+     *
+     * The default implementation sets the attributes and writes the text
+     * (or skips the characters) of every run. Then it breaks the line.
+     *
+     * @param text_ The text of the line
+     * @param length_ Length of the text
+     * @param runs_ The runs. They follow one another, the sum of their
+     *     lengths is @a length_.
+     * @param runs_count_ Number of the runs
+     */
+    virtual void writeStyledLine(
+        const char* text_,
+        int length_,
+        const StyleRun* runs_,
+        int runs_count_);
+
     /**
      * @brief Set font style
      */
@@ -118,6 +162,18 @@ class LineDriver {
      */
     virtual void setBackgroundColor(
         Color color_) = 0;
+
+  protected:
+    enum {
+      SPACES_LENGTH = 256,
+    };
+
+    /**
+     * @brief Get a buffer of SPACES_LENGTH spaces
+     *
+     * The buffer is shared by the bulk operations of the drivers.
+     */
+    static const char* getSpaces() noexcept;
 };
 
 } /* -- namespace Typograph */
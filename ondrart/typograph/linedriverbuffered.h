@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__LINEDRIVERBUFFERED_H_
+#define OndraRT__LINEDRIVERBUFFERED_H_
+
+#include <vector>
+
+#include <ondrart/typograph/linedriver.h>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+/**
+ * @brief A line driver composing whole lines for another driver
+ *
+ * The driver collects the text of current line and runs of its attributes
+ * in reusable buffers. The attribute changes are merged: a new run starts
+ * only if some text is written with attributes different from the previous
+ * run. The skipped characters are kept as separate runs, so the target
+ * driver can still handle them specially. The complete line is passed
+ * to the target driver by one call of the LineDriver::writeStyledLine()
+ * method.
+ */
+class LineDriverBuffered : public LineDriver {
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param target_ The target driver. The ownership is not taken.
+     */
+    explicit LineDriverBuffered(
+        LineDriver* target_);
+
+    /**
+     * @brief Dtor
+     *
+     * An unfinished line is written into the target driver without
+     * breaking it.
+     */
+    virtual ~LineDriverBuffered();
+
+    /* -- avoid copying */
+    LineDriverBuffered(
+        const LineDriverBuffered&) = delete;
+    LineDriverBuffered& operator =(
+        const LineDriverBuffered&) = delete;
+
+    /* -- line driver */
+    virtual void skipChars(
+        int chars_) override;
+    virtual void writeText(
+        const char* text_,
+        int length_) override;
+    virtual void breakLine() override;
+    virtual void finishLine(
+        int chars_) override;
+    virtual void writeStyledLine(
+        const char* text_,
+        int length_,
+        const StyleRun* runs_,
+        int runs_count_) override;
+    virtual void setFontStyle(
+        FontStyle style_) override;
+    virtual void setFontWeight(
+        FontWeight weight_) override;
+    virtual void setForegroundColor(
+        Color color_) override;
+    virtual void setBackgroundColor(
+        Color color_) override;
+
+  private:
+    StyleRun& prepareRun(
+        bool skipped_);
+    void appendText(
+        const char* text_,
+        int length_);
+    void appendSkip(
+        int chars_);
+
+    LineDriver* target;
+    StyleRun current;
+    std::vector<char> line;
+    std::vector<StyleRun> runs;
+};
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__LINEDRIVERBUFFERED_H_ */
@@ -70,6 +70,13 @@ class LineDriverIos : public LineDriver {
         const char* text_,
         int length_) override;
     virtual void breakLine() override;
+    virtual void finishLine(
+        int chars_) override;
+    virtual void writeStyledLine(
+        const char* text_,
+        int length_,
+        const StyleRun* runs_,
+        int runs_count_) override;
     virtual void setFontStyle(
         FontStyle style_) override;
     virtual void setFontWeight(
@@ -80,6 +87,10 @@ class LineDriverIos : public LineDriver {
         Color color_) override;
 
   private:
+    void writeFill(
+        char fill_,
+        int chars_);
+
     std::ostream* os;
     LineSync sync;
 };
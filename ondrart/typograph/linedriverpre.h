@@ -21,6 +21,7 @@
 #define OndraRT__LINEDRIVERPRE_H_
 
 #include <iosfwd>
+#include <string>
 
 #include <ondrart/typograph/linedriver.h>
 
@@ -53,6 +54,13 @@ class LineDriverPre : public LineDriver {
         const char* text_,
         int length_) override;
     virtual void breakLine() override;
+    virtual void finishLine(
+        int chars_) override;
+    virtual void writeStyledLine(
+        const char* text_,
+        int length_,
+        const StyleRun* runs_,
+        int runs_count_) override;
     virtual void setFontStyle(
         FontStyle style_) override;
     virtual void setFontWeight(
@@ -63,9 +71,19 @@ class LineDriverPre : public LineDriver {
         Color color_) override;
 
   private:
-    void printColor(
+    void writeFill(
+        char fill_,
+        int chars_);
+    static void appendColor(
+        std::string& out_,
         const char* style_,
         Color color_);
+    static bool appendSpan(
+        std::string& out_,
+        FontStyle font_style_,
+        FontWeight font_weight_,
+        Color foreground_,
+        Color background_);
     void openSpan();
     void closeSpan();
 
@@ -76,6 +94,7 @@ class LineDriverPre : public LineDriver {
     FontWeight font_weight;
     Color foreground;
     Color background;
+    std::string buffer;
 };
 
 } /* -- namespace Typograph */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__LINEDRIVERTAPE_H_
+#define OndraRT__LINEDRIVERTAPE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include <ondrart/typograph/linedriver.h>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+/**
+ * @brief A line driver recording the calls for a later replay
+ *
+ * The driver stores every call with its arguments (including copies
+ * of the texts) in a compact tape. The replay() method repeats the calls
+ * into another driver in the same order, so the target driver receives
+ * exactly the same output as if it was used directly.
+ *
+ * The tape allows to render blocks in another thread than the one owning
+ * the target driver.
+ */
+class LineDriverTape : public LineDriver {
+  public:
+    /**
+     * @brief Ctor
+     */
+    LineDriverTape();
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~LineDriverTape();
+
+    /* -- avoid copying */
+    LineDriverTape(
+        const LineDriverTape&) = delete;
+    LineDriverTape& operator =(
+        const LineDriverTape&) = delete;
+
+    /**
+     * @brief Replay the recorded calls
+     *
+     * @param target_ The target driver
+     */
+    void replay(
+        LineDriver& target_) const;
+
+    /**
+     * @brief Replay a part of the recorded calls
+     *
+     * @param target_ The target driver
+     * @param begin_ Beginning of the part. It's a value returned by
+     *     the getPosition() method.
+     * @param end_ End of the part (a value returned by the getPosition()
+     *     method)
+     */
+    void replay(
+        LineDriver& target_,
+        std::size_t begin_,
+        std::size_t end_) const;
+
+    /**
+     * @brief Get current position in the tape
+     *
+     * The position marks the end of the calls recorded so far.
+     */
+    std::size_t getPosition() const noexcept;
+
+    /**
+     * @brief Forget the recorded calls
+     *
+     * The memory of the tape is kept for next recording.
+     */
+    void clear() noexcept;
+
+    /* -- line driver */
+    virtual void skipChars(
+        int chars_) override;
+    virtual void writeText(
+        const char* text_,
+        int length_) override;
+    virtual void breakLine() override;
+    virtual void finishLine(
+        int chars_) override;
+    virtual void writeStyledLine(
+        const char* text_,
+        int length_,
+        const StyleRun* runs_,
+        int runs_count_) override;
+    virtual void setFontStyle(
+        FontStyle style_) override;
+    virtual void setFontWeight(
+        FontWeight weight_) override;
+    virtual void setForegroundColor(
+        Color color_) override;
+    virtual void setBackgroundColor(
+        Color color_) override;
+
+  private:
+    void appendCall(
+        char call_,
+        int arg_);
+    void appendData(
+        const void* data_,
+        std::size_t size_);
+
+    std::vector<char> tape;
+};
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__LINEDRIVERTAPE_H_ */
@@ -20,12 +20,13 @@
 #ifndef OndraRT__TYPOGRAPH_H_
 #define OndraRT__TYPOGRAPH_H_
 
+#include <ondrart/typograph/typographblock.h>
+
 namespace OndraRT {
 
 namespace Typograph {
 
 class LineDriver;
-class TypographBlock;
 
 /**
  * @brief A typograph object
@@ -66,7 +67,47 @@ class Typograph {
     void writeBlock(
         TypographBlock& block_);
 
+    /**
+     * @brief Write a sequence of text blocks
+     *
+     * The output is the same as if the blocks were written one by one by
+     * the writeBlock() method. The lines of the blocks are laid out
+     * concurrently in worker threads into private tapes which are then
+     * replayed in order into the line driver. Only a small window
+     * of the blocks (a few blocks per thread) is laid out ahead
+     * of the replayed one. If no thread can be started, the blocks
+     * are laid out by the calling thread. The margins between
+     * the blocks are collapsed in the same way as by the writeBlock()
+     * method.
+     *
+     * The blocks are laid out concurrently, hence they must not share
+     * any nested blocks.
+     *
+     * @param blocks_ Array of the blocks
+     * @param count_ Number of the blocks
+     * @param threads_ Number of the threads laying out the blocks
+     *     (including the calling one). Zero or negative value means
+     *     the number of the CPU cores.
+     * @exception TypoError If a block cannot be formatted. The blocks
+     *     before the failed one and the lines of the failed block written
+     *     before the error are passed into the line driver as by
+     *     the writeBlock() method.
+     */
+    void writeBlocks(
+        TypographBlock* const* blocks_,
+        int count_,
+        int threads_ = 0);
+
   private:
+    void writeTopMargin(
+        int top_);
+    void writeLines(
+        LineDriver& driver_,
+        TypographBlock& block_,
+        const TypographBlock::Border& margin_) const;
+    void writeBottomMargin(
+        int bottom_);
+
     LineDriver* driver;
     int width;
     int last_bottom_margin;
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__TYPOGRAPHARENA_H_
+#define OndraRT__TYPOGRAPHARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+/**
+ * @brief A monotonic memory arena
+ *
+ * The memory is allocated from big chunks and it's never freed separately.
+ * The reset() method destroys all objects created in the arena and rewinds
+ * the chunks, so they are reused for next allocations.
+ */
+class TypographArena {
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param chunk_size_ Size of the first chunk. Next chunks are bigger.
+     */
+    explicit TypographArena(
+        std::size_t chunk_size_ = 1024);
+
+    /**
+     * @brief Dtor
+     */
+    ~TypographArena();
+
+    /* -- avoid copying */
+    TypographArena(
+        const TypographArena&) = delete;
+    TypographArena& operator =(
+        const TypographArena&) = delete;
+
+    /**
+     * @brief Allocate raw memory
+     *
+     * @param size_ Size of the memory
+     * @param align_ Required alignment (a power of two)
+     */
+    void* allocate(
+        std::size_t size_,
+        std::size_t align_);
+
+    /**
+     * @brief Create new object in the arena
+     *
+     * The object is destroyed by the reset() method or by the destructor
+     * of the arena (in the reverse order of creation).
+     *
+     * @param args_ Arguments of the object's constructor
+     */
+    template<typename Object_, typename... Args_>
+    Object_* create(
+        Args_&&... args_) {
+      void* memory_(allocate(sizeof(Object_), alignof(Object_)));
+      Object_* object_(new(memory_) Object_(std::forward<Args_>(args_)...));
+      if(!std::is_trivially_destructible<Object_>::value) {
+        try {
+          registerDestructor(object_, &destroyObject<Object_>);
+        }
+        catch(...) {
+          object_->~Object_();
+          throw;
+        }
+      }
+      return object_;
+    }
+
+    /**
+     * @brief Destroy all objects and rewind the memory
+     */
+    void reset() noexcept;
+
+  private:
+    typedef void (*DestroyFunction)(void*);
+
+    template<typename Object_>
+    static void destroyObject(
+        void* object_) {
+      static_cast<Object_*>(object_)->~Object_();
+    }
+
+    void registerDestructor(
+        void* object_,
+        DestroyFunction destroy_);
+
+    struct Chunk {
+      std::unique_ptr<char[]> memory;
+      std::size_t size;
+    };
+
+    struct Destructor {
+      Destructor* next;
+      void* object;
+      DestroyFunction destroy;
+    };
+
+    std::size_t chunk_size;
+    std::vector<Chunk> chunks;
+    std::size_t current_chunk;
+    std::size_t offset;
+    Destructor* destructors;
+};
+
+/**
+ * @brief Standard allocator allocating memory in an arena
+ *
+ * The deallocation does nothing, the memory is released by the arena.
+ */
+template<typename Type_>
+class TypographArenaAllocator {
+  public:
+    typedef Type_ value_type;
+
+    explicit TypographArenaAllocator(
+        TypographArena* arena_) noexcept :
+      arena(arena_) {
+
+    }
+
+    template<typename Other_>
+    TypographArenaAllocator(
+        const TypographArenaAllocator<Other_>& other_) noexcept :
+      arena(other_.arena) {
+
+    }
+
+    Type_* allocate(
+        std::size_t count_) {
+      return static_cast<Type_*>(
+          arena->allocate(count_ * sizeof(Type_), alignof(Type_)));
+    }
+
+    void deallocate(
+        Type_*,
+        std::size_t) noexcept {
+      /* -- the memory is released by the arena */
+    }
+
+    template<typename Other_>
+    bool operator ==(
+        const TypographArenaAllocator<Other_>& other_) const noexcept {
+      return arena == other_.arena;
+    }
+
+    template<typename Other_>
+    bool operator !=(
+        const TypographArenaAllocator<Other_>& other_) const noexcept {
+      return arena != other_.arena;
+    }
+
+  private:
+    template<typename Other_> friend class TypographArenaAllocator;
+
+    TypographArena* arena;
+};
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__TYPOGRAPHARENA_H_ */
@@ -44,6 +44,16 @@ class TypographBlock {
           const Border& other_) const;
     };
 
+    /**
+     * @brief Measured widths of block's content
+     */
+    struct Measure {
+      int min;    /**< width of the widest unbreakable part of the content
+                       (the longest word) */
+      int max;    /**< width of the whole content written without
+                       wrapping */
+    };
+
   public:
     TypographBlock();
     virtual ~TypographBlock();
@@ -78,6 +88,21 @@ class TypographBlock {
      * @brief Get block's margins
      */
     virtual Border getMargin() const noexcept = 0;
+
+    /**
+     * @brief Rewind the block to the beginning of its content
+     *
+     * The block can be printed again then (even at another width).
+     */
+    virtual void reset() noexcept = 0;
+
+    /**
+     * @brief Measure widths of the content
+     *
+     * The measure is used for automatic sizing of columns. The margins
+     * of the block are not included.
+     */
+    virtual Measure measure() const noexcept = 0;
 };
 
 } /* -- namespace Typograph */
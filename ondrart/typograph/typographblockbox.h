@@ -86,6 +86,8 @@ class TypographBlockBox : public TypographBlock {
         const TypographState& origin_) override;
     virtual bool isFinished() const noexcept override;
     virtual Border getMargin() const noexcept override;
+    virtual void reset() noexcept override;
+    virtual Measure measure() const noexcept override;
 
   private:
     TypographBlock* block;
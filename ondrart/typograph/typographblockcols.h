@@ -20,19 +20,50 @@
 #ifndef OndraRT__TYPOGRAPHBLOCKCOLS_H_
 #define OndraRT__TYPOGRAPHBLOCKCOLS_H_
 
+#include <climits>
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 #include <ondrart/typograph/typographblock.h>
+#include <ondrart/typograph/typographstate.h>
 
 namespace OndraRT {
 
 namespace Typograph {
 
+class LineDriverTape;
+
 /**
  * @brief Formatting of several text columns
+ *
+ * By default the lines of the columns are written one by one directly
+ * into the line driver. In the concurrent mode (see setConcurrent())
+ * whole columns are laid out ahead, in parallel, into private tapes
+ * at the first line. Then the lines of the tapes are zipped together.
+ * The output is the same in both modes.
  */
 class TypographBlockCols : public TypographBlock {
   public:
+    enum {
+      WIDTH_VARIABLE = -1,  /**< the column shares the rest of the line
+                                 with other variable columns */
+      WIDTH_AUTO = INT_MIN, /**< the column is sized by its content */
+    };
+
+    /**
+     * @brief Description of a column
+     *
+     * A positive width is a fixed width of the column. The WIDTH_AUTO
+     * columns get widths between the minimal and maximal widths of their
+     * content (see TypographBlock::measure()). They grow only while
+     * the variable columns keep their minimal content widths. If there
+     * is not enough space for the minimal widths, the auto columns are
+     * narrowed further and their long words are broken. Other
+     * non-positive widths mean a variable column. (The auto sizing must
+     * be requested explicitly by the WIDTH_AUTO value, which is out
+     * of the range of common negative widths.)
+     */
     struct Column {
       TypographBlock* block;
       int width;
@@ -60,6 +91,25 @@ class TypographBlockCols : public TypographBlock {
     TypographBlockCols& operator =(
         const TypographBlockCols&) = delete;
 
+    /**
+     * @brief Set the concurrent mode
+     *
+     * The concurrent mode pays off for many columns with long wrapped
+     * texts. The columns must not share any nested blocks. The width
+     * and the next width passed into the block must not change after
+     * the first line, otherwise the TypoError exception is thrown. All
+     * layout errors are thrown at the first line before any output
+     * is written.
+     *
+     * @param concurrent_ True to lay out the columns concurrently
+     * @param threads_ Number of the threads laying out the columns
+     *     (including the calling one). Zero or negative value means
+     *     the number of the CPU cores.
+     */
+    void setConcurrent(
+        bool concurrent_,
+        int threads_ = 0);
+
     /* -- typograph block */
     virtual void writeLine(
         LineDriver& driver_,
@@ -68,9 +118,63 @@ class TypographBlockCols : public TypographBlock {
         const TypographState& origin_) override;
     virtual bool isFinished() const noexcept override;
     virtual Border getMargin() const noexcept override;
+    virtual void reset() noexcept override;
+    virtual Measure measure() const noexcept override;
 
   private:
+    void prepareGeometry();
+    bool distributeWidths(
+        int width_,
+        std::vector<int>& widths_,
+        int& allocated_) const;
+    int solveWidths(
+        int width_,
+        int next_width_);
+    void layoutColumns(
+        const TypographState& origin_);
+    void writeColumn(
+        int column_,
+        LineDriver& driver_,
+        const TypographState& origin_);
+    void releaseTapes() noexcept;
+
+    /* -- Lines of a column laid out ahead. The line N is stored between
+     *    the positions N - 1 and N of the lines vector (the line 0 starts
+     *    at the beginning of the tape). */
+    struct ColumnTape {
+      std::unique_ptr<LineDriverTape> tape;
+      std::vector<std::size_t> lines;
+    };
+
     std::vector<Column> columns;
+
+    /* -- Geometry of the columns. It's computed once per layout: the gaps
+     *    between the columns and the measures of the auto columns don't
+     *    change till the block is reset. */
+    bool geometry_ready;
+    std::vector<int> gaps;
+    std::vector<Measure> measures;
+    int fixed_space;
+    int var_count;
+    long long var_reserve;
+
+    /* -- widths solved for the last pair of the width and next width */
+    bool solved;
+    int solved_width;
+    int solved_next_width;
+    int solved_allocated;
+    std::vector<int> widths;
+    std::vector<int> next_widths;
+
+    /* -- concurrent mode */
+    bool concurrent;
+    int threads;
+    bool laid_out;
+    int current_line;
+    int line_count;
+    int layout_width;
+    TypographState layout_origin;
+    std::vector<ColumnTape> tapes;
 };
 
 } /* -- namespace Typograph */
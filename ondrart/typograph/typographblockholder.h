@@ -21,16 +21,25 @@
 #define OndraRT__TYPOGRAPHBLOCKHOLDER_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include <ondrart/typograph/typographarena.h>
+
 namespace OndraRT {
 
 namespace Typograph {
 
+class TypoLayout;
 class TypographBlock;
+class TypographBlockText;
 
 /**
  * @brief A helper holder of the ownership of typograph blocks
+ *
+ * The blocks created by the holder and the layouts of their texts are
+ * allocated in a monotonic arena. The reset() method releases them
+ * at once and the holder can be reused for next blocks.
  */
 class TypographBlockHolder {
   public:
@@ -44,6 +53,12 @@ class TypographBlockHolder {
      */
     ~TypographBlockHolder();
 
+    /* -- avoid copying */
+    TypographBlockHolder(
+        const TypographBlockHolder&) = delete;
+    TypographBlockHolder& operator =(
+        const TypographBlockHolder&) = delete;
+
     /**
      * @brief Get the ownership of a block
      *
@@ -63,12 +78,38 @@ class TypographBlockHolder {
     template<typename Block_, typename... Args_>
     Block_* createBlock(
         Args_&&... args_) {
-      return static_cast<Block_*>(holdBlock(
-          std::unique_ptr<Block_>(new Block_(std::forward<Args_>(args_)...))));
+      return arena.create<Block_>(std::forward<Args_>(args_)...);
     }
 
+    /**
+     * @brief Parse a text into a layout stored in the arena
+     *
+     * @param text_ The text
+     * @return The layout. It's valid till the holder is reset.
+     * @exception TypoError if the text is not valid
+     */
+    std::shared_ptr<const TypoLayout> createLayout(
+        const char* text_);
+
+    /**
+     * @brief Create new text block with the layout stored in the arena
+     *
+     * @param text_ The text
+     * @exception TypoError if the text is not valid
+     */
+    TypographBlockText* createText(
+        const std::string& text_);
+
+    /**
+     * @brief Destroy all blocks
+     *
+     * The memory of the arena is kept for next blocks.
+     */
+    void reset() noexcept;
+
   private:
     std::vector<std::unique_ptr<TypographBlock>> blocks;
+    TypographArena arena;
 };
 
 } /* -- namespace Typograph */
@@ -59,6 +59,8 @@ class TypographBlockSeq : public TypographBlock {
         const TypographState& origin_) override;
     virtual bool isFinished() const noexcept override;
     virtual Border getMargin() const noexcept override;
+    virtual void reset() noexcept override;
+    virtual Measure measure() const noexcept override;
 
   public:
     TypographBlock** blocks;
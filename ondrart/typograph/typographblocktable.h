@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__TYPOGRAPHBLOCKTABLE_H_
+#define OndraRT__TYPOGRAPHBLOCKTABLE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ondrart/typograph/typographblock.h>
+#include <ondrart/typograph/typographblockholder.h>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+class TypographBlockCols;
+class TypographRowSource;
+
+/**
+ * @brief A table pulling its rows from a row source
+ *
+ * The rows are read one by one when they are printed. The cells of the
+ * current row are laid out in reusable blocks which are discarded when
+ * the row is finished, so the memory doesn't depend on the number
+ * of the rows.
+ *
+ * The widths of the columns are the same for all rows. They are solved
+ * as in the case of the TypographBlockCols block. The contents of
+ * the auto columns are measured from a sample of the first rows
+ * when the table is measured or when its first line is printed.
+ *
+ * The table isn't known to be empty until its first line is printed.
+ * Hence an empty table prints one empty line.
+ */
+class TypographBlockTable : public TypographBlock {
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param source_ The source of the rows. The ownership is not taken.
+     * @param widths_ Widths of the columns. The values have the same
+     *     meaning as TypographBlockCols::Column::width.
+     * @param colsnum_ Number of the columns
+     */
+    explicit TypographBlockTable(
+        TypographRowSource* source_,
+        const int* widths_,
+        int colsnum_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~TypographBlockTable();
+
+    /* -- avoid copying */
+    TypographBlockTable(
+        const TypographBlockTable&) = delete;
+    TypographBlockTable& operator =(
+        const TypographBlockTable&) = delete;
+
+    /**
+     * @brief Set space between the columns
+     *
+     * @param gap_ Number of characters between the columns (default 1)
+     */
+    void setGap(
+        int gap_);
+
+    /**
+     * @brief Set size of the sample measuring the auto columns
+     *
+     * @param rows_ Number of the first rows measured before the table
+     *     is printed (default 100). The sampled rows are kept in memory.
+     */
+    void setSampleRows(
+        int rows_);
+
+    /* -- typograph block */
+    virtual void writeLine(
+        LineDriver& driver_,
+        int width_,
+        int next_width_,
+        const TypographState& origin_) override;
+    virtual bool isFinished() const noexcept override;
+    virtual Border getMargin() const noexcept override;
+    virtual void reset() noexcept override;
+    virtual Measure measure() const noexcept override;
+
+  private:
+    class Cell;
+
+    void sampleRows() const;
+    bool loadRow();
+
+    TypographRowSource* source;
+    int colsnum;
+    std::unique_ptr<Cell[]> cells;
+    std::unique_ptr<TypographBlockCols> cols;
+    int sample_limit;
+
+    /* -- Texts of the sampled rows (row by row). The sample is taken
+     *    lazily by the measure() method too, hence the sampling state
+     *    is mutable. */
+    mutable std::vector<std::string> sample;
+    mutable int sample_count;
+    int sample_next;
+
+    mutable bool sampled;
+    mutable bool exhausted;
+    mutable bool rewind;
+    bool started;
+    bool finished;
+
+    /* -- blocks of the current row */
+    mutable TypographBlockHolder holder;
+};
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__TYPOGRAPHBLOCKTABLE_H_ */
@@ -20,12 +20,12 @@
 #ifndef OndraRT__TYPOGRAPHBLOCKTEXT_H_
 #define OndraRT__TYPOGRAPHBLOCKTEXT_H_
 
+#include <memory>
 #include <string>
-#include <vector>
 
 #include <ondrart/typograph/typographblock.h>
 #include <ondrart/typograph/typographstate.h>
-#include <ondrart/typograph/typotokenizer.h>
+#include <ondrart/typograph/typolayout.h>
 
 namespace OndraRT {
 
@@ -33,19 +33,33 @@ namespace Typograph {
 
 /**
  * @brief A typograph block formatting specified text into a block
+ *
+ * The block renders a parsed text layout (see TypoLayout). The layout
+ * may be shared by many blocks. The block keeps just the rendering
+ * position, so it can be rewound by the reset() method and rendered
+ * again (even at another width).
  */
 class TypographBlockText : public TypographBlock {
   public:
     /**
      * @brief Ctor
      *
-     * @param text_ The specified text
+     * @param text_ The specified text. It's parsed immediately.
+     * @exception TypoError if the text is not valid
      */
     explicit TypographBlockText(
         const std::string& text_);
     explicit TypographBlockText(
         std::string&& text_);
 
+    /**
+     * @brief Ctor
+     *
+     * @param layout_ Parsed text. The layout is shared.
+     */
+    explicit TypographBlockText(
+        std::shared_ptr<const TypoLayout> layout_);
+
     /**
      * @brief Dtor
      */
@@ -65,6 +79,8 @@ class TypographBlockText : public TypographBlock {
         const TypographState& origin_);
     bool isFinished() const noexcept;
     virtual Border getMargin() const noexcept override;
+    virtual void reset() noexcept override;
+    virtual Measure measure() const noexcept override;
 
   private:
     void flushPrepared(
@@ -75,15 +91,15 @@ class TypographBlockText : public TypographBlock {
         int& line_fill_,
         bool line_begin_);
 
-    std::string text;
-    TypoTokenizer tokenizer;
+    std::shared_ptr<const TypoLayout> layout;
     TypographState state;
+    int next_word;
 
-    /* -- prepared sequence of formatting commands */
-    int remained_out;
-    std::string remained_word;
+    /* -- prepared word (-1 if there is none) and its printed part */
+    int prepared_word;
     int prepared_index;
-    std::vector<TypoTokenizer::Token> prepared;
+    int remained_out;
+    int token_out;
 
     bool finished;
 };
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__TYPOGRAPHROWSOURCE_H_
+#define OndraRT__TYPOGRAPHROWSOURCE_H_
+
+namespace OndraRT {
+
+namespace Typograph {
+
+/**
+ * @brief A source of rows of a table
+ *
+ * The source is read sequentially by the TypographBlockTable block.
+ * Only the current row is needed at a time, so the rows can be
+ * generated on demand.
+ */
+class TypographRowSource {
+  public:
+    /**
+     * @brief Ctor
+     */
+    TypographRowSource();
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~TypographRowSource();
+
+    /* -- avoid copying */
+    TypographRowSource(
+        const TypographRowSource&) = delete;
+    TypographRowSource& operator =(
+        const TypographRowSource&) = delete;
+
+    /**
+     * @brief Move to next row
+     *
+     * The source is positioned before the first row initially.
+     *
+     * @return False if there is no more row
+     */
+    virtual bool nextRow() = 0;
+
+    /**
+     * @brief Get text of a cell of the current row
+     *
+     * @param column_ Index of the column
+     * @return The text of the cell (with the typograph markup). The text
+     *     must be valid till next call of nextRow() or rewind().
+     */
+    virtual const char* getCell(
+        int column_) = 0;
+
+    /**
+     * @brief Move the source before the first row again
+     */
+    virtual void rewind() = 0;
+};
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__TYPOGRAPHROWSOURCE_H_ */
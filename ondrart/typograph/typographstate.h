@@ -75,6 +75,14 @@ class TypographState {
     TypographState& operator =(
         const TypographState& other_);
 
+    /**
+     * @brief Compare the states
+     */
+    bool operator ==(
+        const TypographState& other_) const noexcept;
+    bool operator !=(
+        const TypographState& other_) const noexcept;
+
   private:
     LineDriver::FontStyle font_style;
     LineDriver::FontWeight font_weight;
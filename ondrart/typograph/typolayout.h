@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__TYPOLAYOUT_H_
+#define OndraRT__TYPOLAYOUT_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <ondrart/typograph/typotokenizer.h>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+class TypographArena;
+
+/**
+ * @brief Parsed form of a formatted text
+ *
+ * The layout keeps the tokens of a text in a flat array. The tokens are
+ * grouped into words (sequences of the text and the attribute tokens
+ * between two spaces). Texts of a word are stored in one piece and
+ * the length of the word is precomputed.
+ *
+ * The layout is immutable once it's constructed. Hence, one layout
+ * can be shared by many text blocks and it can be rendered at any width
+ * without running the tokenizer again.
+ *
+ * The words, the tokens and the characters are stored in one memory
+ * block which can be allocated in an arena.
+ */
+class TypoLayout {
+  public:
+    struct Word {
+      int first_token;       /**< index of the first token of the word */
+      int end_token;         /**< index behind the last token */
+      std::size_t offset;    /**< offset of the word's text */
+      std::size_t length;    /**< length of the word's text */
+      bool last;             /**< the word is terminated by the end
+                                  of the text (not by a space) */
+    };
+
+  public:
+    /**
+     * @brief Ctor - parse a text
+     *
+     * @param text_ The text
+     * @exception TypoError if the text is not valid
+     */
+    explicit TypoLayout(
+        const char* text_);
+    explicit TypoLayout(
+        const std::string& text_);
+
+    /**
+     * @brief Ctor - parse a text and store the layout in an arena
+     *
+     * @param text_ The text
+     * @param arena_ The arena. The layout is valid till the arena is
+     *     reset.
+     * @exception TypoError if the text is not valid
+     */
+    explicit TypoLayout(
+        const char* text_,
+        TypographArena* arena_);
+
+    /**
+     * @brief Dtor
+     */
+    ~TypoLayout();
+
+    /* -- avoid copying */
+    TypoLayout(
+        const TypoLayout&) = delete;
+    TypoLayout& operator =(
+        const TypoLayout&) = delete;
+
+    /**
+     * @brief Get number of words
+     */
+    int getWordCount() const noexcept;
+
+    /**
+     * @brief Get a word
+     *
+     * @param index_ Index of the word
+     */
+    const Word& getWord(
+        int index_) const noexcept;
+
+    /**
+     * @brief Get a token
+     *
+     * @param index_ Index of the token
+     */
+    const TypoTokenizer::Token& getToken(
+        int index_) const noexcept;
+
+    /**
+     * @brief Get text of a word
+     */
+    const char* getText(
+        const Word& word_) const noexcept;
+
+  private:
+    void parse(
+        const char* text_,
+        TypographArena* arena_);
+
+    std::unique_ptr<char[]> storage;
+    const Word* words;
+    int word_count;
+    const TypoTokenizer::Token* tokens;
+    int token_count;
+    const char* chars;
+};
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__TYPOLAYOUT_H_ */
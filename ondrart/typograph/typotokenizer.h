@@ -22,8 +22,7 @@
 
 #include "linedriver.h"
 
-#include <sstream>
-#include <string>
+#include <vector>
 
 namespace OndraRT {
 
@@ -34,6 +33,11 @@ namespace Typograph {
  *
  * This class breaks a text into a stream of tokens. The tokenizer supports
  * special tags changing text attributes or text colors.
+ *
+ * The text tokens point into the parsed text directly. Only the words
+ * containing escape sequences are composed in an internal scratch buffer,
+ * which is reused by next words. Hence, a text token is valid until next
+ * call of the nextToken() method.
  */
 class TypoTokenizer {
   public:
@@ -81,15 +85,21 @@ class TypoTokenizer {
     Token nextToken();
 
   private:
-    Token finishBuffer();
-    Token handleTag();
+    Token finishText(
+        const char* begin_,
+        bool escaped_);
+    Token handleTag(
+        const char* name_,
+        int name_length_,
+        const char* value_,
+        int value_length_);
     LineDriver::Color parseColor(
-        const std::string& value_);
+        const char* value_,
+        int length_);
 
     const char* text;
     const char* current;
-    std::ostringstream buffer;
-    std::string token_text;
+    std::vector<char> scratch;
     LineDriver::FontStyle font_style;
     LineDriver::FontWeight font_weight;
 };
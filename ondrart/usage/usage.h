@@ -50,6 +50,17 @@ enum class PresenceArg {
     NOT_EMPTY, /**< mandatory but it cannot be empty */
 };
 
+/**
+ * @brief Handler of option arguments
+ *
+ * The handler is invoked with the argument at every occurrence of
+ * the option during the parsing. The argument is nullptr if an optional
+ * argument is omitted. The handler returns false if the argument is not
+ * valid. See the usagevalue.h for handlers converting the arguments
+ * into typed values.
+ */
+typedef std::function<bool(const char* value_)> ValueHandler;
+
 /**
  * @brief A facility parsing command line options
  *
@@ -144,10 +155,23 @@ class Usage {
      * @brief Open a section
      *
      * This opens a section -> all nested items will be indented.
+     * The title is used as the name of the section (see printSection())
+     * if no section of the same name exists.
+     *
+     * @param title_ Title of the section
+     */
+    void openSection(
+        const std::string& title_);
+
+    /**
+     * @brief Open a named section
      *
+     * @param name_ Name of the section used by the printSection() method
      * @param title_ Title of the section
+     * @exception UsageError if a section of the same name already exists
      */
     void openSection(
+        const std::string& name_,
         const std::string& title_);
 
     /**
@@ -159,6 +183,8 @@ class Usage {
      * @param long_ The long option. It can be empty, if there is no long
      *     version
      * @param help_ Help text associated with the option.
+     * @exception UsageError if the short or the long option is already
+     *     registered
      */
     void addOption(
         Presence presence_,
@@ -177,6 +203,8 @@ class Usage {
      * @param arg_presence_ Presence of the argument (mandatory/optional)
      * @param arg_name_ Name of the argument (shown in the help)
      * @param help_ Help text associated with the option
+     * @exception UsageError if the short or the long option is already
+     *     registered
      */
     void addOptionArg(
         Presence presence_,
@@ -186,6 +214,31 @@ class Usage {
         const std::string& arg_name_,
         const std::string& help_);
 
+    /**
+     * @brief Add new command line option with an argument processed
+     *     by a handler
+     *
+     * @param presence_ Presence of the option (mandatory/optional)
+     * @param short_ The short option. It can be zero, if there is no short
+     *     version
+     * @param long_ The long option. It can be empty, if there is no long
+     *     version
+     * @param arg_presence_ Presence of the argument (mandatory/optional)
+     * @param arg_name_ Name of the argument (shown in the help)
+     * @param help_ Help text associated with the option
+     * @param handler_ Handler of the argument (e.g. bindValue())
+     * @exception UsageError if the short or the long option is already
+     *     registered
+     */
+    void addOptionArg(
+        Presence presence_,
+        char short_,
+        const std::string& long_,
+        PresenceArg arg_presence_,
+        const std::string& arg_name_,
+        const std::string& help_,
+        const ValueHandler& handler_);
+
     /**
      * @brief Add free text
      *
@@ -210,18 +263,111 @@ class Usage {
      */
     void closeSection();
 
+    /**
+     * @brief Parse the command line
+     *
+     * The options and the positional arguments may be mixed. The parameter
+     * "--" finishes the options. Short options may be grouped ("-abc"),
+     * their arguments follow immediately or in next parameter. The long
+     * options take arguments as "--name=value" or in next parameter
+     * (the optional arguments only in the former form).
+     *
+     * A parameter "@file" is replaced by the parameters read from the
+     * response file. The parameters in the file are separated by white
+     * spaces which can be quoted by single or double quotes or escaped
+     * by a backslash. The response files can be nested.
+     *
+     * The values are not copied, they point into the argv array or into
+     * the response files which are kept in the memory till next parsing.
+     * The response files may be pipes too (e.g. a process substitution
+     * of the shell).
+     *
+     * @exception UsageError if the command line is not valid (an unknown
+     *     option, a missing or invalid argument or a violated presence
+     *     of an option)
+     *     or if a response file cannot be read or it's included
+     *     recursively
+     */
+    void parseCommandLine();
+
+    /**
+     * @brief Get number of occurrences of an option at the command line
+     *
+     * @param short_ The short option
+     * @exception UsageError if the option is not registered
+     */
+    int getOptionCount(
+        char short_) const;
+
+    /**
+     * @brief Get number of occurrences of an option at the command line
+     *
+     * @param long_ The long option
+     * @exception UsageError if the option is not registered
+     */
+    int getOptionCount(
+        const std::string& long_) const;
+
+    /**
+     * @brief Get argument of an option
+     *
+     * @param short_ The short option
+     * @param occurrence_ Index of the occurrence of the option
+     * @return The argument or nullptr if there is no such occurrence
+     *     or if the optional argument is omitted
+     * @exception UsageError if the option is not registered
+     */
+    const char* getOptionValue(
+        char short_,
+        int occurrence_ = 0) const;
+
+    /**
+     * @brief Get argument of an option
+     *
+     * @param long_ The long option
+     * @param occurrence_ Index of the occurrence of the option
+     * @return The argument or nullptr if there is no such occurrence
+     *     or if the optional argument is omitted
+     * @exception UsageError if the option is not registered
+     */
+    const char* getOptionValue(
+        const std::string& long_,
+        int occurrence_ = 0) const;
+
+    /**
+     * @brief Get number of positional arguments
+     */
+    int getArgumentCount() const;
+
+    /**
+     * @brief Get a positional argument
+     *
+     * @param index_ Index of the argument
+     * @return The argument or nullptr if the index is out of range
+     */
+    const char* getArgument(
+        int index_) const;
+
     /**
      * @brief Print usage into the standard output
+     *
+     * The output is handled as terminal if the standard output is
+     * a terminal.
      */
     void printUsage();
 
     /**
      * @brief Print usage into a stream
      *
+     * The formatted blocks and the rendered output are cached between
+     * the calls, so printing of the usage again (e.g. after the terminal
+     * is resized) just re-flows the texts or it copies the output.
+     *
      * @param os_ The stream
      * @param width_ Width of the output in characters. If the the value
-     *     is negative, the width is detected or the default (80 characters)
-     *     is used.
+     *     is negative, the width is detected (from the terminal if the
+     *     stream is the standard output or error, or from the COLUMNS
+     *     environment variable) or the default (80 characters) is used.
      * @param terminal_ True if the stream should be handled as terminal
      *     (the control sequences will be printed)
      */
@@ -230,6 +376,54 @@ class Usage {
         int width_,
         bool terminal_);
 
+    /**
+     * @brief Print usage of one section
+     *
+     * Only the records of the section are formatted. The section is
+     * printed without indentation of its parent sections.
+     *
+     * @param os_ The stream
+     * @param name_ Name of the section (see openSection())
+     * @param width_ Width of the output (see printUsage())
+     * @param terminal_ True if the stream should be handled as terminal
+     * @exception UsageError if the section doesn't exist
+     */
+    void printSection(
+        std::ostream& os_,
+        const std::string& name_,
+        int width_,
+        bool terminal_);
+
+    /**
+     * @brief Print usage of one option
+     *
+     * @param os_ The stream
+     * @param short_ The short option
+     * @param width_ Width of the output (see printUsage())
+     * @param terminal_ True if the stream should be handled as terminal
+     * @exception UsageError if the option is not registered
+     */
+    void printOption(
+        std::ostream& os_,
+        char short_,
+        int width_,
+        bool terminal_);
+
+    /**
+     * @brief Print usage of one option
+     *
+     * @param os_ The stream
+     * @param long_ The long option
+     * @param width_ Width of the output (see printUsage())
+     * @param terminal_ True if the stream should be handled as terminal
+     * @exception UsageError if the option is not registered
+     */
+    void printOption(
+        std::ostream& os_,
+        const std::string& long_,
+        int width_,
+        bool terminal_);
+
   private:
     struct Impl;
     Impl* pimpl;
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__USAGEERROR_H_
+#define OndraRT__USAGEERROR_H_
+
+#include <string>
+
+namespace OndraRT {
+
+namespace Usage {
+
+class UsageError {
+  public:
+    explicit UsageError(
+        const std::string& message_);
+    UsageError(
+        UsageError&&);
+    ~UsageError();
+
+    /* -- avoid copying */
+    UsageError(
+        const UsageError&) = delete;
+    UsageError& operator =(
+        const UsageError&) = delete;
+
+  public:
+    std::string message;
+};
+
+} /* -- namespace Usage */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__USAGEERROR_H_ */
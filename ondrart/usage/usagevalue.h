@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__USAGEVALUE_H_
+#define OndraRT__USAGEVALUE_H_
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <ondrart/usage/usage.h>
+
+namespace OndraRT {
+
+namespace Usage {
+
+/*
+ * Parsers of option values
+ *
+ * The parsers convert a range of characters into a value. They don't
+ * allocate memory (except the strings and the lists, obviously) and they
+ * don't modify the value if the text is not valid. The range must be
+ * terminated by a separator (a comma) or by the zero character.
+ */
+
+bool parseSigned(
+    const char* begin_,
+    const char* end_,
+    long long& value_);
+bool parseUnsigned(
+    const char* begin_,
+    const char* end_,
+    unsigned long long& value_);
+bool parseFloating(
+    const char* begin_,
+    const char* end_,
+    long double& value_);
+
+/**
+ * @brief Parse a duration in seconds
+ *
+ * The number can be followed by one of the suffixes ns, us, ms, s, m
+ * (or min), h and d.
+ *
+ * @param begin_ Beginning of the text
+ * @param end_ End of the text
+ * @param[out] value_ The duration in seconds
+ * @param[out] suffix_ True if the unit suffix is present
+ */
+bool parseDuration(
+    const char* begin_,
+    const char* end_,
+    long double& value_,
+    bool& suffix_);
+
+/**
+ * @brief Size in bytes
+ *
+ * The value can be written with the binary suffixes K, M, G, T, P and E
+ * (case insensitive) optionally followed by "B" or "iB".
+ */
+struct ByteSize {
+    std::uint64_t bytes;
+};
+
+/**
+ * @brief Name of an enumeration value
+ */
+template<typename Enum_>
+struct EnumName {
+    const char* name;
+    Enum_ value;
+};
+
+/**
+ * @brief Parse a boolean value (true/false, yes/no, on/off, 1/0)
+ */
+bool parseValue(
+    const char* begin_,
+    const char* end_,
+    bool& value_);
+
+bool parseValue(
+    const char* begin_,
+    const char* end_,
+    ByteSize& value_);
+
+bool parseValue(
+    const char* begin_,
+    const char* end_,
+    std::string& value_);
+
+template<typename Int_>
+typename std::enable_if<
+    std::is_integral<Int_>::value
+        && std::is_signed<Int_>::value,
+    bool>::type parseValue(
+    const char* begin_,
+    const char* end_,
+    Int_& value_) {
+  long long tmp_;
+  if(!parseSigned(begin_, end_, tmp_)
+      || tmp_ < std::numeric_limits<Int_>::min()
+      || tmp_ > std::numeric_limits<Int_>::max())
+    return false;
+  value_ = static_cast<Int_>(tmp_);
+  return true;
+}
+
+template<typename Int_>
+typename std::enable_if<
+    std::is_integral<Int_>::value
+        && std::is_unsigned<Int_>::value
+        && !std::is_same<Int_, bool>::value,
+    bool>::type parseValue(
+    const char* begin_,
+    const char* end_,
+    Int_& value_) {
+  unsigned long long tmp_;
+  if(!parseUnsigned(begin_, end_, tmp_)
+      || tmp_ > std::numeric_limits<Int_>::max())
+    return false;
+  value_ = static_cast<Int_>(tmp_);
+  return true;
+}
+
+template<typename Float_>
+typename std::enable_if<
+    std::is_floating_point<Float_>::value,
+    bool>::type parseValue(
+    const char* begin_,
+    const char* end_,
+    Float_& value_) {
+  long double tmp_;
+  if(!parseFloating(begin_, end_, tmp_))
+    return false;
+  value_ = static_cast<Float_>(tmp_);
+  return true;
+}
+
+/**
+ * @brief Parse a duration
+ *
+ * A value without the unit suffix is a count of the units of the duration.
+ */
+template<typename Rep_, typename Period_>
+bool parseValue(
+    const char* begin_,
+    const char* end_,
+    std::chrono::duration<Rep_, Period_>& value_) {
+  long double tmp_;
+  bool suffix_;
+  if(!parseDuration(begin_, end_, tmp_, suffix_))
+    return false;
+  if(suffix_)
+    tmp_ = tmp_ * Period_::den / Period_::num;
+  if(!std::is_floating_point<Rep_>::value)
+    tmp_ = std::floor(tmp_ + 0.5L);
+  if(tmp_ < std::numeric_limits<Rep_>::lowest()
+      || tmp_ > std::numeric_limits<Rep_>::max())
+    return false;
+  value_ = std::chrono::duration<Rep_, Period_>(static_cast<Rep_>(tmp_));
+  return true;
+}
+
+/**
+ * @brief Parse a comma separated list
+ *
+ * The items are appended to the list. Nothing is appended if some item
+ * is not valid.
+ */
+template<typename Value_>
+bool parseValue(
+    const char* begin_,
+    const char* end_,
+    std::vector<Value_>& value_) {
+  std::vector<Value_> items_;
+  for(;;) {
+    const char* sep_(static_cast<const char*>(
+        std::memchr(begin_, ',', end_ - begin_)));
+    if(sep_ == nullptr)
+      sep_ = end_;
+    Value_ item_ = Value_();
+    if(!parseValue(begin_, sep_, item_))
+      return false;
+    items_.push_back(std::move(item_));
+    if(sep_ == end_)
+      break;
+    begin_ = sep_ + 1;
+  }
+
+  value_.insert(
+      value_.end(),
+      std::make_move_iterator(items_.begin()),
+      std::make_move_iterator(items_.end()));
+  return true;
+}
+
+/**
+ * @brief Bind a variable to an option
+ *
+ * The value is converted and stored into the variable at every occurrence
+ * of the option (the lists are appended). The variable is not changed
+ * if an optional argument is omitted.
+ *
+ * @param target_ The variable. It must live during the parsing.
+ * @return The value handler (see Usage::addOptionArg())
+ */
+template<typename Value_>
+ValueHandler bindValue(
+    Value_* target_) {
+  return [target_](const char* value_) -> bool {
+    if(value_ == nullptr)
+      return true;
+    return parseValue(value_, value_ + std::strlen(value_), *target_);
+  };
+}
+
+/**
+ * @brief Bind a string variable to an option
+ *
+ * The variable is set to point to the argument (into the argv array
+ * or into a response file). No conversion or copying is done.
+ */
+ValueHandler bindValue(
+    const char** target_);
+
+/**
+ * @brief Bind a callback to an option
+ *
+ * The callback is invoked with the converted value at every occurrence
+ * of the option. It's not invoked if an optional argument is omitted.
+ */
+template<typename Value_>
+ValueHandler bindValue(
+    std::function<void(const Value_&)> callback_) {
+  return [callback_](const char* value_) -> bool {
+    if(value_ == nullptr)
+      return true;
+    Value_ tmp_ = Value_();
+    if(!parseValue(value_, value_ + std::strlen(value_), tmp_))
+      return false;
+    callback_(tmp_);
+    return true;
+  };
+}
+
+/**
+ * @brief Bind an enumeration variable to an option
+ *
+ * @param target_ The variable
+ * @param names_ Names of the enumeration values accepted as the argument
+ */
+template<typename Enum_>
+ValueHandler bindEnum(
+    Enum_* target_,
+    std::initializer_list<EnumName<Enum_>> names_) {
+  std::vector<EnumName<Enum_>> table_(names_);
+  return [target_, table_](const char* value_) -> bool {
+    if(value_ == nullptr)
+      return true;
+    for(const auto& name_ : table_) {
+      if(std::strcmp(name_.name, value_) == 0) {
+        *target_ = name_.value;
+        return true;
+      }
+    }
+    return false;
+  };
+}
+
+} /* -- namespace Usage */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__USAGEVALUE_H_ */
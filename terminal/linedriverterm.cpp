@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "linedriverterm.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <iostream>
+
+namespace OndraRT {
+
+namespace Terminal {
+
+namespace {
+
+/* -- longest sequence: "\033[0;3;1;37;47m" */
+enum { SEQUENCE_LENGTH = 32 };
+
+char* appendCode(
+    char* pos_,
+    int code_) noexcept {
+  assert(code_ >= 0 && code_ < 100);
+  if(code_ >= 10)
+    *pos_++ = '0' + code_ / 10;
+  *pos_++ = '0' + code_ % 10;
+  *pos_++ = ';';
+  return pos_;
+}
+
+int colorCode(
+    int base_,
+    LineDriverTerm::Color color_) noexcept {
+  if(color_ == LineDriverTerm::C_DEFAULT)
+    return base_ + 9;
+  else
+    return base_ + (color_ - LineDriverTerm::C_BLACK);
+}
+
+/* -- append codes changing attributes @a from_ to @a to_ */
+char* appendDifferences(
+    char* pos_,
+    const LineDriverTerm::Attributes& from_,
+    const LineDriverTerm::Attributes& to_) noexcept {
+  if(from_.italic != to_.italic)
+    pos_ = appendCode(pos_, to_.italic ? 3 : 23);
+  if(from_.bold != to_.bold)
+    pos_ = appendCode(pos_, to_.bold ? 1 : 22);
+  if(from_.foreground != to_.foreground)
+    pos_ = appendCode(pos_, colorCode(30, to_.foreground));
+  if(from_.background != to_.background)
+    pos_ = appendCode(pos_, colorCode(40, to_.background));
+  return pos_;
+}
+
+const LineDriverTerm::Attributes DEFAULT_ATTRIBUTES{
+    false, false, LineDriverTerm::C_DEFAULT, LineDriverTerm::C_DEFAULT};
+
+} /* -- namespace */
+
+bool LineDriverTerm::Attributes::operator ==(
+    const Attributes& other_) const noexcept {
+  return italic == other_.italic
+      && bold == other_.bold
+      && foreground == other_.foreground
+      && background == other_.background;
+}
+
+bool LineDriverTerm::Attributes::operator !=(
+    const Attributes& other_) const noexcept {
+  return !(*this == other_);
+}
+
+LineDriverTerm::LineDriverTerm(
+    std::ostream* os_,
+    std::size_t buffer_size_) :
+  os(os_),
+  buffer_size(buffer_size_),
+  terminal(DEFAULT_ATTRIBUTES),
+  requested(DEFAULT_ATTRIBUTES),
+  spaces(0) {
+  assert(os != nullptr && buffer_size > 0);
+
+  buffer.reserve(buffer_size);
+}
+
+LineDriverTerm::~LineDriverTerm() {
+  if(terminal != DEFAULT_ATTRIBUTES)
+    append("\033[0m", 4);
+  writeBuffer();
+}
+
+void LineDriverTerm::flush() {
+  writeBuffer();
+  os->flush();
+}
+
+void LineDriverTerm::applyAttributes(
+    const Attributes& attributes_) {
+  /* -- Two variants are composed: the differences against current state
+   *    of the terminal and a full reset followed by the non-default
+   *    attributes. The shorter one is emitted. */
+  char diff_[SEQUENCE_LENGTH];
+  char reset_[SEQUENCE_LENGTH];
+  diff_[0] = reset_[0] = '\033';
+  diff_[1] = reset_[1] = '[';
+  char* diff_end_(appendDifferences(diff_ + 2, terminal, attributes_));
+  char* reset_end_(appendDifferences(
+      appendCode(reset_ + 2, 0), DEFAULT_ATTRIBUTES, attributes_));
+
+  if(reset_end_ - reset_ <= diff_end_ - diff_) {
+    reset_end_[-1] = 'm';
+    append(reset_, reset_end_ - reset_);
+  }
+  else {
+    diff_end_[-1] = 'm';
+    append(diff_, diff_end_ - diff_);
+  }
+  terminal = attributes_;
+}
+
+void LineDriverTerm::writeSpaces() {
+  if(spaces > 0) {
+    if(terminal.background != C_DEFAULT) {
+      Attributes attributes_(terminal);
+      attributes_.background = C_DEFAULT;
+      applyAttributes(attributes_);
+    }
+    appendFill(' ', spaces);
+    spaces = 0;
+  }
+}
+
+void LineDriverTerm::syncAttributes() {
+  writeSpaces();
+  if(requested != terminal)
+    applyAttributes(requested);
+}
+
+void LineDriverTerm::append(
+    const char* text_,
+    std::size_t length_) {
+  if(buffer.size() + length_ > buffer_size) {
+    writeBuffer();
+    if(length_ >= buffer_size) {
+      os->write(text_, length_);
+      return;
+    }
+  }
+  buffer.append(text_, length_);
+}
+
+void LineDriverTerm::appendFill(
+    char fill_,
+    int chars_) {
+  while(chars_ > 0) {
+    if(buffer.size() >= buffer_size)
+      writeBuffer();
+    const std::size_t length_(std::min<std::size_t>(
+        chars_, buffer_size - buffer.size()));
+    buffer.append(length_, fill_);
+    chars_ -= length_;
+  }
+}
+
+void LineDriverTerm::appendBreak() {
+  /* -- the trailing spaces are not visible */
+  spaces = 0;
+
+  /* -- A non-default background is reset before the line break. Otherwise
+   *    the terminal could fill the new line with the background color
+   *    when it scrolls. */
+  if(terminal.background != C_DEFAULT) {
+    Attributes attributes_(terminal);
+    attributes_.background = C_DEFAULT;
+    applyAttributes(attributes_);
+  }
+  append("\n", 1);
+}
+
+void LineDriverTerm::writeBuffer() {
+  if(!buffer.empty()) {
+    os->write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+}
+
+void LineDriverTerm::skipChars(
+    int chars_) {
+  /* -- The spaces are visible only if the background color is set.
+   *    Otherwise they are postponed and they are dropped at the end
+   *    of the line. */
+  if(requested.background == C_DEFAULT)
+    spaces += chars_;
+  else {
+    syncAttributes();
+    appendFill(' ', chars_);
+  }
+}
+
+void LineDriverTerm::writeText(
+    const char* text_,
+    int length_) {
+  assert(text_ != nullptr && length_ >= 0);
+  syncAttributes();
+  append(text_, length_);
+}
+
+void LineDriverTerm::breakLine() {
+  appendBreak();
+}
+
+void LineDriverTerm::finishLine(
+    int chars_) {
+  skipChars(chars_);
+  appendBreak();
+}
+
+void LineDriverTerm::writeStyledLine(
+    const char* text_,
+    int length_,
+    const StyleRun* runs_,
+    int runs_count_) {
+  assert(text_ != nullptr && length_ >= 0);
+  assert(runs_ != nullptr || runs_count_ == 0);
+
+  for(int i_(0); i_ < runs_count_; ++i_) {
+    const StyleRun& run_(runs_[i_]);
+    assert(run_.length <= length_);
+    requested.italic = (run_.font_style == FS_ITALIC);
+    requested.bold = (run_.font_weight == FW_BOLD);
+    requested.foreground = run_.foreground;
+    requested.background = run_.background;
+    if(run_.skipped)
+      skipChars(run_.length);
+    else {
+      syncAttributes();
+      append(text_, run_.length);
+    }
+    text_ += run_.length;
+    length_ -= run_.length;
+  }
+  if(length_ > 0) {
+    syncAttributes();
+    append(text_, length_);
+  }
+  appendBreak();
+}
+
+void LineDriverTerm::setFontStyle(
+    FontStyle style_) {
+  requested.italic = (style_ == FS_ITALIC);
+}
+
+void LineDriverTerm::setFontWeight(
+    FontWeight weight_) {
+  requested.bold = (weight_ == FW_BOLD);
+}
+
+void LineDriverTerm::setForegroundColor(
+    Color color_) {
+  requested.foreground = color_;
+}
+
+void LineDriverTerm::setBackgroundColor(
+    Color color_) {
+  requested.background = color_;
+}
+
+} /* -- namespace Terminal */
+
+} /* -- namespace OndraRT */
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Encode or decode a whole file in the base64
+ *
+ * Usage: base64_file [-d] [-u] [-w LINE_LENGTH] INPUT OUTPUT
+ *   -d  decode the input (the default is encoding)
+ *   -u  use the URL and filename safe alphabet
+ *   -w  break the encoded lines (ignored by the decoding)
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <ondrart/base64/base64error.h>
+#include <ondrart/base64/file.h>
+
+namespace B = ::OndraRT::Base64;
+
+namespace {
+
+void printHelp(
+    const char* program_) {
+  std::cerr
+      << "usage: " << program_ << " [-d] [-u] [-w LINE_LENGTH] INPUT OUTPUT\n";
+}
+
+} /* -- namespace */
+
+int main(
+    int argc_,
+    char* argv_[]) {
+  bool decode_(false);
+  bool url_(false);
+  int line_length_(-1);
+
+  int i_(1);
+  for(; i_ < argc_ && argv_[i_][0] == '-'; ++i_) {
+    if(std::strcmp(argv_[i_], "-d") == 0)
+      decode_ = true;
+    else if(std::strcmp(argv_[i_], "-u") == 0)
+      url_ = true;
+    else if(std::strcmp(argv_[i_], "-w") == 0 && i_ + 1 < argc_)
+      line_length_ = std::atoi(argv_[++i_]);
+    else {
+      printHelp(argv_[0]);
+      return 1;
+    }
+  }
+  if(argc_ - i_ != 2) {
+    printHelp(argv_[0]);
+    return 1;
+  }
+
+  try {
+    const char* input_(argv_[i_]);
+    const char* output_(argv_[i_ + 1]);
+    if(decode_) {
+      if(url_)
+        B::decodeFile<B::AlphabetUrl>(input_, output_);
+      else
+        B::decodeFile<B::AlphabetStandard>(input_, output_);
+    }
+    else {
+      if(url_)
+        B::encodeFile<B::AlphabetUrl>(input_, output_, line_length_);
+      else
+        B::encodeFile<B::AlphabetStandard>(input_, output_, line_length_);
+    }
+  }
+  catch(B::Base64Error& error_) {
+    std::cerr << argv_[0] << ": " << error_.message << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -19,6 +19,8 @@
 
 #include "linedriver.h"
 
+#include <cstring>
+
 namespace OndraRT {
 
 namespace Typograph {
@@ -31,6 +33,44 @@ LineDriver::~LineDriver() {
 
 }
 
+void LineDriver::finishLine(
+    int chars_) {
+  skipChars(chars_);
+  breakLine();
+}
+
+void LineDriver::writeStyledLine(
+    const char* text_,
+    int,
+    const StyleRun* runs_,
+    int runs_count_) {
+  for(int i_(0); i_ < runs_count_; ++i_) {
+    const StyleRun& run_(runs_[i_]);
+    setFontStyle(run_.font_style);
+    setFontWeight(run_.font_weight);
+    setForegroundColor(run_.foreground);
+    setBackgroundColor(run_.background);
+    if(run_.skipped)
+      skipChars(run_.length);
+    else
+      writeText(text_, run_.length);
+    text_ += run_.length;
+  }
+  breakLine();
+}
+
+const char* LineDriver::getSpaces() noexcept {
+  struct Spaces {
+    Spaces() {
+      std::memset(data, ' ', sizeof(data));
+    }
+
+    char data[SPACES_LENGTH];
+  };
+  static const Spaces spaces_;
+  return spaces_.data;
+}
+
 } /* -- namespace Typograph */
 
 } /* -- namespace OndraRT */
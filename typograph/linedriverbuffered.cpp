@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "linedriverbuffered.h"
+
+#include <assert.h>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+LineDriverBuffered::LineDriverBuffered(
+    LineDriver* target_) :
+  target(target_),
+  current{0, FS_DEFAULT, FW_DEFAULT, C_DEFAULT, C_DEFAULT, false},
+  line(),
+  runs() {
+  assert(target != nullptr);
+
+}
+
+LineDriverBuffered::~LineDriverBuffered() {
+  /* -- write rest of the unfinished line */
+  const char* text_(line.data());
+  for(const auto& run_ : runs) {
+    target->setFontStyle(run_.font_style);
+    target->setFontWeight(run_.font_weight);
+    target->setForegroundColor(run_.foreground);
+    target->setBackgroundColor(run_.background);
+    if(run_.skipped)
+      target->skipChars(run_.length);
+    else
+      target->writeText(text_, run_.length);
+    text_ += run_.length;
+  }
+}
+
+LineDriver::StyleRun& LineDriverBuffered::prepareRun(
+    bool skipped_) {
+  /* -- continue the last run if the attributes are not changed */
+  if(!runs.empty()) {
+    StyleRun& last_(runs.back());
+    if(last_.skipped == skipped_
+        && last_.font_style == current.font_style
+        && last_.font_weight == current.font_weight
+        && last_.foreground == current.foreground
+        && last_.background == current.background) {
+      return last_;
+    }
+  }
+
+  runs.push_back(current);
+  runs.back().skipped = skipped_;
+  return runs.back();
+}
+
+void LineDriverBuffered::appendText(
+    const char* text_,
+    int length_) {
+  if(length_ > 0) {
+    prepareRun(false).length += length_;
+    line.insert(line.end(), text_, text_ + length_);
+  }
+}
+
+void LineDriverBuffered::appendSkip(
+    int chars_) {
+  if(chars_ > 0) {
+    prepareRun(true).length += chars_;
+    line.insert(line.end(), chars_, ' ');
+  }
+}
+
+void LineDriverBuffered::skipChars(
+    int chars_) {
+  appendSkip(chars_);
+}
+
+void LineDriverBuffered::writeText(
+    const char* text_,
+    int length_) {
+  assert(text_ != nullptr && length_ >= 0);
+  appendText(text_, length_);
+}
+
+void LineDriverBuffered::breakLine() {
+  target->writeStyledLine(line.data(), line.size(), runs.data(), runs.size());
+  line.clear();
+  runs.clear();
+}
+
+void LineDriverBuffered::finishLine(
+    int chars_) {
+  appendSkip(chars_);
+  breakLine();
+}
+
+void LineDriverBuffered::writeStyledLine(
+    const char* text_,
+    int,
+    const StyleRun* runs_,
+    int runs_count_) {
+  for(int i_(0); i_ < runs_count_; ++i_) {
+    const StyleRun& run_(runs_[i_]);
+    current.font_style = run_.font_style;
+    current.font_weight = run_.font_weight;
+    current.foreground = run_.foreground;
+    current.background = run_.background;
+    if(run_.skipped)
+      appendSkip(run_.length);
+    else
+      appendText(text_, run_.length);
+    text_ += run_.length;
+  }
+  breakLine();
+}
+
+void LineDriverBuffered::setFontStyle(
+    FontStyle style_) {
+  current.font_style = style_;
+}
+
+void LineDriverBuffered::setFontWeight(
+    FontWeight weight_) {
+  current.font_weight = weight_;
+}
+
+void LineDriverBuffered::setForegroundColor(
+    Color color_) {
+  current.foreground = color_;
+}
+
+void LineDriverBuffered::setBackgroundColor(
+    Color color_) {
+  current.background = color_;
+}
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
@@ -19,6 +19,7 @@
 
 #include "linedriverios.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
 
@@ -39,10 +40,26 @@ LineDriverIos::~LineDriverIos() {
 
 }
 
+void LineDriverIos::writeFill(
+    char fill_,
+    int chars_) {
+  if(fill_ == ' ') {
+    const char* spaces_(getSpaces());
+    while(chars_ > 0) {
+      const int length_(std::min<int>(chars_, SPACES_LENGTH));
+      os->write(spaces_, length_);
+      chars_ -= length_;
+    }
+  }
+  else {
+    for(int i_(0); i_ < chars_; ++i_)
+      os->put(fill_);
+  }
+}
+
 void LineDriverIos::skipChars(
     int chars_) {
-  for(int i_(0); i_ < chars_; ++i_)
-    os->put(' ');
+  writeFill(' ', chars_);
 }
 
 void LineDriverIos::writeText(
@@ -59,6 +76,22 @@ void LineDriverIos::breakLine() {
     *os << '\n';
 }
 
+void LineDriverIos::finishLine(
+    int chars_) {
+  writeFill(' ', chars_);
+  breakLine();
+}
+
+void LineDriverIos::writeStyledLine(
+    const char* text_,
+    int length_,
+    const StyleRun*,
+    int) {
+  /* -- the attributes are not supported, the skips are written as spaces */
+  os->write(text_, length_);
+  breakLine();
+}
+
 void LineDriverIos::setFontStyle(
     FontStyle style_) {
   /* -- not supported */
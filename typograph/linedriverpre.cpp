@@ -19,8 +19,10 @@
 
 #include "linedriverpre.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
+#include <string>
 
 namespace OndraRT {
 
@@ -34,7 +36,8 @@ LineDriverPre::LineDriverPre(
   font_style(FS_DEFAULT),
   font_weight(FW_DEFAULT),
   foreground(C_DEFAULT),
-  background(C_DEFAULT) {
+  background(C_DEFAULT),
+  buffer() {
   assert(os != nullptr);
 
 }
@@ -43,11 +46,27 @@ LineDriverPre::~LineDriverPre() {
   closeSpan();
 }
 
+void LineDriverPre::writeFill(
+    char fill_,
+    int chars_) {
+  if(fill_ == ' ') {
+    const char* spaces_(getSpaces());
+    while(chars_ > 0) {
+      const int length_(std::min<int>(chars_, SPACES_LENGTH));
+      os->write(spaces_, length_);
+      chars_ -= length_;
+    }
+  }
+  else {
+    for(int i_(0); i_ < chars_; ++i_)
+      os->put(fill_);
+  }
+}
+
 void LineDriverPre::skipChars(
     int chars_) {
   openSpan();
-  for(int i_(0); i_ < chars_; ++i_)
-    os->put(' ');
+  writeFill(' ', chars_);
 }
 
 void LineDriverPre::writeText(
@@ -62,89 +81,162 @@ void LineDriverPre::breakLine() {
   os->put('\n');
 }
 
-void LineDriverPre::printColor(
+void LineDriverPre::writeStyledLine(
+    const char* text_,
+    int,
+    const StyleRun* runs_,
+    int runs_count_) {
+  closeSpan();
+
+  /* -- compose the whole line with its spans */
+  buffer.clear();
+  bool span_(false);
+  for(int i_(0); i_ < runs_count_; ++i_) {
+    const StyleRun& run_(runs_[i_]);
+
+    /* -- The runs may differ only in the skipping. They share the span
+     *    then. */
+    if(i_ == 0
+        || run_.font_style != runs_[i_ - 1].font_style
+        || run_.font_weight != runs_[i_ - 1].font_weight
+        || run_.foreground != runs_[i_ - 1].foreground
+        || run_.background != runs_[i_ - 1].background) {
+      if(span_)
+        buffer += "</span>";
+      span_ = appendSpan(
+          buffer,
+          run_.font_style,
+          run_.font_weight,
+          run_.foreground,
+          run_.background);
+    }
+    buffer.append(text_, run_.length);
+    text_ += run_.length;
+  }
+  if(span_)
+    buffer += "</span>";
+  buffer += '\n';
+  os->write(buffer.data(), buffer.size());
+
+  /* -- the attributes of the last run stay active */
+  if(runs_count_ > 0) {
+    const StyleRun& last_(runs_[runs_count_ - 1]);
+    font_style = last_.font_style;
+    font_weight = last_.font_weight;
+    foreground = last_.foreground;
+    background = last_.background;
+    changed_attributes = true;
+  }
+}
+
+void LineDriverPre::finishLine(
+    int chars_) {
+  openSpan();
+  writeFill(' ', chars_);
+  closeSpan();
+  os->put('\n');
+}
+
+void LineDriverPre::appendColor(
+    std::string& out_,
     const char* style_,
     Color color_) {
   if(color_ != C_DEFAULT) {
-    *os << style_ << ':';
+    out_ += style_;
+    out_ += ':';
     switch(color_) {
       case C_BLACK:
-        *os << "black";
+        out_ += "black";
         break;
       case C_RED:
-        *os << "red";
+        out_ += "red";
         break;
       case C_GREEN:
-        *os << "green";
+        out_ += "green";
         break;
       case C_YELLOW:
-        *os << "yellow";
+        out_ += "yellow";
         break;
       case C_BLUE:
-        *os << "blue";
+        out_ += "blue";
         break;
       case C_MAGENTA:
-        *os << "magenta";
+        out_ += "magenta";
         break;
       case C_CYAN:
-        *os << "cyan";
+        out_ += "cyan";
         break;
       case C_WHITE:
-        *os << "white";
+        out_ += "white";
         break;
       default:
         assert(false);
-        *os << "black";
+        out_ += "black";
         break;
     }
-    *os << ';';
+    out_ += ';';
   }
 }
 
+bool LineDriverPre::appendSpan(
+    std::string& out_,
+    FontStyle font_style_,
+    FontWeight font_weight_,
+    Color foreground_,
+    Color background_) {
+  if(font_style_ == FS_DEFAULT && font_weight_ == FW_DEFAULT
+      && foreground_ == C_DEFAULT && background_ == C_DEFAULT) {
+    return false;
+  }
+
+  out_ += "<span style=\"";
+
+  if(font_style_ != FS_DEFAULT) {
+    out_ += "font-style:";
+    switch(font_style_) {
+      case FS_NORMAL:
+        out_ += "normal";
+        break;
+      case FS_ITALIC:
+        out_ += "italic";
+        break;
+      default:
+        assert(false);
+        break;
+    }
+    out_ += ';';
+  }
+
+  if(font_weight_ != FW_DEFAULT) {
+    out_ += "font-weight:";
+    switch(font_weight_) {
+      case FW_NORMAL:
+        out_ += "normal";
+        break;
+      case FW_BOLD:
+        out_ += "bold";
+        break;
+      default:
+        assert(false);
+        break;
+    }
+    out_ += ';';
+  }
+
+  appendColor(out_, "color", foreground_);
+  appendColor(out_, "background-color", background_);
+
+  out_ += "\">";
+  return true;
+}
+
 void LineDriverPre::openSpan() {
   if(changed_attributes) {
     closeSpan();
 
-    if(font_style != FS_DEFAULT || font_weight != FW_DEFAULT
-        || foreground != C_DEFAULT || background != C_DEFAULT) {
-      *os << "<span style=\"";
-
-      if(font_style != FS_DEFAULT) {
-        *os << "font-style:";
-        switch(font_style) {
-          case FS_NORMAL:
-            *os << "normal";
-            break;
-          case FS_ITALIC:
-            *os << "italic";
-            break;
-          default:
-            assert(false);
-            break;
-        }
-        *os << ';';
-      }
-
-      if(font_weight != FW_DEFAULT) {
-        *os << "font-weight:";
-        switch(font_weight) {
-          case FW_NORMAL:
-            *os << "normal";
-            break;
-          case FW_BOLD:
-            *os << "bold";
-            break;
-          default:
-            assert(false);
-            break;
-        }
-        *os << ';';
-      }
-
-      printColor("color", foreground);
-      printColor("background-color", background);
-
-      *os << "\">";
+    buffer.clear();
+    if(appendSpan(buffer, font_style, font_weight, foreground, background)) {
+      os->write(buffer.data(), buffer.size());
       opened_span = true;
       changed_attributes = false;
     }
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "linedrivertape.h"
+
+#include <assert.h>
+#include <cstring>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+namespace {
+
+/* -- Codes of the recorded calls. Every call is stored as the code
+ *    followed by one integer argument. The texts and the style runs
+ *    follow the argument. */
+enum Call : char {
+  CALL_SKIP_CHARS,
+  CALL_WRITE_TEXT,
+  CALL_BREAK_LINE,
+  CALL_FINISH_LINE,
+  CALL_WRITE_STYLED_LINE,
+  CALL_FONT_STYLE,
+  CALL_FONT_WEIGHT,
+  CALL_FOREGROUND,
+  CALL_BACKGROUND,
+};
+
+int readInt(
+    const char*& data_) {
+  int value_;
+  std::memcpy(&value_, data_, sizeof(value_));
+  data_ += sizeof(value_);
+  return value_;
+}
+
+} /* -- namespace */
+
+LineDriverTape::LineDriverTape() {
+
+}
+
+LineDriverTape::~LineDriverTape() {
+
+}
+
+void LineDriverTape::appendCall(
+    char call_,
+    int arg_) {
+  tape.push_back(call_);
+  appendData(&arg_, sizeof(arg_));
+}
+
+void LineDriverTape::appendData(
+    const void* data_,
+    std::size_t size_) {
+  const char* bytes_(static_cast<const char*>(data_));
+  tape.insert(tape.end(), bytes_, bytes_ + size_);
+}
+
+void LineDriverTape::replay(
+    LineDriver& target_) const {
+  replay(target_, 0, tape.size());
+}
+
+void LineDriverTape::replay(
+    LineDriver& target_,
+    std::size_t begin_,
+    std::size_t end_) const {
+  assert(begin_ <= end_ && end_ <= tape.size());
+
+  const char* data_(tape.data() + begin_);
+  const char* const data_end_(tape.data() + end_);
+  std::vector<StyleRun> runs_;
+  while(data_ < data_end_) {
+    const char call_(*data_++);
+    const int arg_(readInt(data_));
+    switch(call_) {
+      case CALL_SKIP_CHARS:
+        target_.skipChars(arg_);
+        break;
+      case CALL_WRITE_TEXT:
+        target_.writeText(data_, arg_);
+        data_ += arg_;
+        break;
+      case CALL_BREAK_LINE:
+        target_.breakLine();
+        break;
+      case CALL_FINISH_LINE:
+        target_.finishLine(arg_);
+        break;
+      case CALL_WRITE_STYLED_LINE: {
+        /* -- the runs are copied as they may be misaligned in the tape */
+        const int runs_count_(readInt(data_));
+        runs_.resize(runs_count_);
+        std::memcpy(runs_.data(), data_, runs_count_ * sizeof(StyleRun));
+        data_ += runs_count_ * sizeof(StyleRun);
+        target_.writeStyledLine(data_, arg_, runs_.data(), runs_count_);
+        data_ += arg_;
+        break;
+      }
+      case CALL_FONT_STYLE:
+        target_.setFontStyle(static_cast<FontStyle>(arg_));
+        break;
+      case CALL_FONT_WEIGHT:
+        target_.setFontWeight(static_cast<FontWeight>(arg_));
+        break;
+      case CALL_FOREGROUND:
+        target_.setForegroundColor(static_cast<Color>(arg_));
+        break;
+      case CALL_BACKGROUND:
+        target_.setBackgroundColor(static_cast<Color>(arg_));
+        break;
+    }
+  }
+}
+
+std::size_t LineDriverTape::getPosition() const noexcept {
+  return tape.size();
+}
+
+void LineDriverTape::clear() noexcept {
+  tape.clear();
+}
+
+void LineDriverTape::skipChars(
+    int chars_) {
+  appendCall(CALL_SKIP_CHARS, chars_);
+}
+
+void LineDriverTape::writeText(
+    const char* text_,
+    int length_) {
+  appendCall(CALL_WRITE_TEXT, length_);
+  appendData(text_, length_);
+}
+
+void LineDriverTape::breakLine() {
+  appendCall(CALL_BREAK_LINE, 0);
+}
+
+void LineDriverTape::finishLine(
+    int chars_) {
+  appendCall(CALL_FINISH_LINE, chars_);
+}
+
+void LineDriverTape::writeStyledLine(
+    const char* text_,
+    int length_,
+    const StyleRun* runs_,
+    int runs_count_) {
+  appendCall(CALL_WRITE_STYLED_LINE, length_);
+  appendData(&runs_count_, sizeof(runs_count_));
+  appendData(runs_, runs_count_ * sizeof(StyleRun));
+  appendData(text_, length_);
+}
+
+void LineDriverTape::setFontStyle(
+    FontStyle style_) {
+  appendCall(CALL_FONT_STYLE, style_);
+}
+
+void LineDriverTape::setFontWeight(
+    FontWeight weight_) {
+  appendCall(CALL_FONT_WEIGHT, weight_);
+}
+
+void LineDriverTape::setForegroundColor(
+    Color color_) {
+  appendCall(CALL_FOREGROUND, color_);
+}
+
+void LineDriverTape::setBackgroundColor(
+    Color color_) {
+  appendCall(CALL_BACKGROUND, color_);
+}
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
@@ -19,11 +19,17 @@
 
 #include "typograph.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <exception>
+#include <memory>
+#include <thread>
 
 #include "linedriver.h"
+#include "linedrivertape.h"
 #include "typographblock.h"
 #include "typographstate.h"
+#include "typoworkers.h"
 
 namespace OndraRT {
 
@@ -43,40 +49,119 @@ Typograph::~Typograph() {
 
 }
 
-void Typograph::writeBlock(
-    TypographBlock& block_) {
-  auto margin_(block_.getMargin());
-  if(margin_.top > last_bottom_margin)
-    margin_.top -= last_bottom_margin;
-
-  /* -- print top margin */
-  for(int i_(0); i_ < margin_.top; ++i_) {
-    driver->skipChars(width);
-    driver->breakLine();
-  }
+void Typograph::writeTopMargin(
+    int top_) {
+  if(top_ > last_bottom_margin)
+    top_ -= last_bottom_margin;
+  for(int i_(0); i_ < top_; ++i_)
+    driver->finishLine(width);
+}
 
+void Typograph::writeLines(
+    LineDriver& driver_,
+    TypographBlock& block_,
+    const TypographBlock::Border& margin_) const {
   const int box_width_(width - margin_.left - margin_.right);
   TypographState state_;
   while(!block_.isFinished()) {
     /* -- print left margin */
-    driver->skipChars(margin_.left);
+    driver_.skipChars(margin_.left);
 
     /* -- print the line */
-    block_.writeLine(*driver, box_width_, box_width_, state_);
+    block_.writeLine(driver_, box_width_, box_width_, state_);
 
-    /* -- print right margin */
-    driver->skipChars(margin_.right);
+    /* -- print right margin and break the line */
+    driver_.finishLine(margin_.right);
+  }
+}
+
+void Typograph::writeBottomMargin(
+    int bottom_) {
+  for(int i_(0); i_ < bottom_; ++i_)
+    driver->finishLine(width);
+  last_bottom_margin = bottom_;
+}
 
-    /* -- break the line */
-    driver->breakLine();
+void Typograph::writeBlock(
+    TypographBlock& block_) {
+  const auto margin_(block_.getMargin());
+  writeTopMargin(margin_.top);
+  writeLines(*driver, block_, margin_);
+  writeBottomMargin(margin_.bottom);
+}
+
+namespace {
+
+/* -- number of blocks rendered ahead per one thread */
+constexpr int WINDOW_BLOCKS_PER_THREAD(4);
+
+struct RenderedBlock {
+  TypographBlock::Border margin;
+  std::unique_ptr<LineDriverTape> tape;
+  std::exception_ptr error;
+
+  RenderedBlock() :
+    margin{0, 0, 0, 0} {
+
+  }
+};
+
+} /* -- namespace */
+
+void Typograph::writeBlocks(
+    TypographBlock* const* blocks_,
+    int count_,
+    int threads_) {
+  assert(blocks_ != nullptr || count_ == 0);
+
+  if(threads_ <= 0)
+    threads_ = std::thread::hardware_concurrency();
+  if(threads_ > count_)
+    threads_ = count_;
+  if(threads_ <= 1) {
+    for(int i_(0); i_ < count_; ++i_)
+      writeBlock(*blocks_[i_]);
+    return;
   }
 
-  /* -- print bottom margin */
-  for(int i_(0); i_ < margin_.bottom; ++i_) {
-    driver->skipChars(width);
-    driver->breakLine();
+  /* -- The blocks are processed in windows. The blocks of a window are
+   *    laid out concurrently into tapes, then the tapes are replayed
+   *    in order. The window limits the memory kept by the rendered
+   *    blocks. The tapes are reused by next windows. */
+  const int window_(std::min(threads_ * WINDOW_BLOCKS_PER_THREAD, count_));
+  std::unique_ptr<RenderedBlock[]> rendered_(new RenderedBlock[window_]);
+  for(int first_(0); first_ < count_; first_ += window_) {
+    const int size_(std::min(window_, count_ - first_));
+    runTasks(
+        [&](int index_) {
+          RenderedBlock& rendered_block_(rendered_[index_]);
+          TypographBlock& block_(*blocks_[first_ + index_]);
+          rendered_block_.margin = block_.getMargin();
+          rendered_block_.error = nullptr;
+          try {
+            if(rendered_block_.tape == nullptr)
+              rendered_block_.tape.reset(new LineDriverTape);
+            else
+              rendered_block_.tape->clear();
+            writeLines(*rendered_block_.tape, block_, rendered_block_.margin);
+          }
+          catch(...) {
+            rendered_block_.error = std::current_exception();
+          }
+        },
+        size_,
+        threads_);
+
+    for(int i_(0); i_ < size_; ++i_) {
+      RenderedBlock& rendered_block_(rendered_[i_]);
+      writeTopMargin(rendered_block_.margin.top);
+      if(rendered_block_.tape != nullptr)
+        rendered_block_.tape->replay(*driver);
+      if(rendered_block_.error)
+        std::rethrow_exception(rendered_block_.error);
+      writeBottomMargin(rendered_block_.margin.bottom);
+    }
   }
-  last_bottom_margin = margin_.bottom;
 }
 
 } /* -- namespace Typograph */
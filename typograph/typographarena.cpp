@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "typographarena.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cstdint>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+namespace {
+
+/* -- the chunks grow up to this size */
+constexpr const std::size_t MAX_CHUNK_SIZE(65536);
+
+} /* -- namespace */
+
+TypographArena::TypographArena(
+    std::size_t chunk_size_) :
+  chunk_size(chunk_size_),
+  chunks(),
+  current_chunk(0),
+  offset(0),
+  destructors(nullptr) {
+  assert(chunk_size > 0);
+
+}
+
+TypographArena::~TypographArena() {
+  reset();
+}
+
+void* TypographArena::allocate(
+    std::size_t size_,
+    std::size_t align_) {
+  assert(align_ > 0 && (align_ & (align_ - 1)) == 0);
+
+  /* -- try current chunk and the chunks rewound by the reset */
+  while(current_chunk < chunks.size()) {
+    Chunk& chunk_(chunks[current_chunk]);
+    char* position_(chunk_.memory.get() + offset);
+    const std::size_t padding_(
+        (align_ - (reinterpret_cast<std::uintptr_t>(position_) & (align_ - 1)))
+        & (align_ - 1));
+    if(offset + padding_ + size_ <= chunk_.size) {
+      offset += padding_ + size_;
+      return position_ + padding_;
+    }
+    ++current_chunk;
+    offset = 0;
+  }
+
+  /* -- allocate new chunk */
+  std::size_t new_size_(chunk_size);
+  if(!chunks.empty())
+    new_size_ = std::min(chunks.back().size * 2, MAX_CHUNK_SIZE);
+  if(new_size_ < size_ + align_)
+    new_size_ = size_ + align_;
+  chunks.push_back({std::unique_ptr<char[]>(new char[new_size_]), new_size_});
+  current_chunk = chunks.size() - 1;
+  offset = 0;
+  return allocate(size_, align_);
+}
+
+void TypographArena::registerDestructor(
+    void* object_,
+    DestroyFunction destroy_) {
+  Destructor* record_(static_cast<Destructor*>(
+      allocate(sizeof(Destructor), alignof(Destructor))));
+  record_->next = destructors;
+  record_->object = object_;
+  record_->destroy = destroy_;
+  destructors = record_;
+}
+
+void TypographArena::reset() noexcept {
+  while(destructors != nullptr) {
+    Destructor* record_(destructors);
+    destructors = record_->next;
+    record_->destroy(record_->object);
+  }
+  current_chunk = 0;
+  offset = 0;
+}
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
@@ -55,6 +55,14 @@ TypographBlockAttrs::Border TypographBlockAttrs::getMargin() const noexcept {
   return block->getMargin();
 }
 
+void TypographBlockAttrs::reset() noexcept {
+  block->reset();
+}
+
+TypographBlockAttrs::Measure TypographBlockAttrs::measure() const noexcept {
+  return block->measure();
+}
+
 } /* -- namespace Typograph */
 
 } /* -- namespace OndraRT */
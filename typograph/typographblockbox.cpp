@@ -74,7 +74,7 @@ TypographBlockBox::~TypographBlockBox() {
 void TypographBlockBox::setPadding(
     int padding_) {
   padding = {padding_, padding_, padding_, padding_};
-  current_top = current_top = padding_;
+  current_top = current_bottom = padding_;
 }
 
 void TypographBlockBox::setPadding(
@@ -139,6 +139,18 @@ TypographBlockBox::Border TypographBlockBox::getMargin() const noexcept {
   return margin.merge(block->getMargin().sub(padding));
 }
 
+void TypographBlockBox::reset() noexcept {
+  current_top = padding.top;
+  current_bottom = padding.bottom;
+  block->reset();
+}
+
+TypographBlockBox::Measure TypographBlockBox::measure() const noexcept {
+  const auto measure_(block->measure());
+  const int padding_(padding.left + padding.right);
+  return {measure_.min + padding_, measure_.max + padding_};
+}
+
 } /* -- namespace Typograph */
 
 } /* -- namespace OndraRT */
@@ -21,9 +21,12 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <limits>
 
 #include "linedriver.h"
+#include "linedrivertape.h"
 #include "typoerror.h"
+#include "typoworkers.h"
 
 namespace OndraRT {
 
@@ -32,7 +35,26 @@ namespace Typograph {
 TypographBlockCols::TypographBlockCols(
     const Column* columns_,
     int colsnum_) :
-  columns(columns_, columns_ + colsnum_) {
+  columns(columns_, columns_ + colsnum_),
+  geometry_ready(false),
+  gaps(colsnum_),
+  measures(colsnum_),
+  fixed_space(0),
+  var_count(0),
+  var_reserve(0),
+  solved(false),
+  solved_width(0),
+  solved_next_width(0),
+  solved_allocated(0),
+  widths(colsnum_),
+  next_widths(colsnum_),
+  concurrent(false),
+  threads(0),
+  laid_out(false),
+  current_line(0),
+  line_count(0),
+  layout_width(0),
+  layout_origin() {
 
 }
 
@@ -40,88 +62,271 @@ TypographBlockCols::~TypographBlockCols() {
 
 }
 
-void TypographBlockCols::writeLine(
-    LineDriver& driver_,
-    int width_,
-    int next_width_,
-    const TypographState& origin_) {
-  /* -- compute widths of columns */
+void TypographBlockCols::setConcurrent(
+    bool concurrent_,
+    int threads_) {
+  concurrent = concurrent_;
+  threads = threads_;
+}
+
+void TypographBlockCols::prepareGeometry() {
+  if(geometry_ready)
+    return;
+
+  /* -- The contents of the variable columns are measured only when
+   *    there are some auto columns, otherwise the widths don't depend
+   *    on the contents. */
+  const bool auto_(std::any_of(
+      columns.begin(),
+      columns.end(),
+      [](const Column& col_){ return col_.width == WIDTH_AUTO; }));
+
+  const int count_(columns.size());
   int fixed_sum_(0);
-  int var_count_(0);
   int inner_space_(0);
   int margin_(0);
-  for(int i_(0); i_ < columns.size(); ++i_) {
-    if(columns[i_].width <= 0)
-      ++var_count_;
-    else
-      fixed_sum_ += columns[i_].width;
-
+  var_count = 0;
+  var_reserve = 0;
+  for(int i_(0); i_ < count_; ++i_) {
+    /* -- space between the columns */
     auto block_margin_(columns[i_].block->getMargin());
+    gaps[i_] = 0;
     if(i_ > 0) {
-      if(margin_ > block_margin_.left)
-        inner_space_ += margin_;
-      else
-        inner_space_ += block_margin_.left;
+      gaps[i_] = std::max(margin_, block_margin_.left);
+      inner_space_ += gaps[i_];
     }
     margin_ = block_margin_.right;
+
+    /* -- the column width */
+    if(columns[i_].width > 0) {
+      fixed_sum_ += columns[i_].width;
+      continue;
+    }
+    if(auto_) {
+      const auto measure_(columns[i_].block->measure());
+      measures[i_].min = std::max(measure_.min, 1);
+      measures[i_].max = std::max(measure_.max, measures[i_].min);
+    }
+    if(columns[i_].width != WIDTH_AUTO) {
+      ++var_count;
+      var_reserve += auto_ ? measures[i_].min : 1;
+    }
+  }
+  fixed_space = inner_space_ + fixed_sum_;
+  geometry_ready = true;
+}
+
+bool TypographBlockCols::distributeWidths(
+    int width_,
+    std::vector<int>& widths_,
+    int& allocated_) const {
+  const int count_(columns.size());
+  long long auto_min_(0);
+  long long auto_max_(0);
+  int auto_count_(0);
+  for(int i_(0); i_ < count_; ++i_) {
+    if(columns[i_].width == WIDTH_AUTO) {
+      auto_min_ += measures[i_].min;
+      auto_max_ += measures[i_].max;
+      ++auto_count_;
+    }
   }
 
   /* -- requested columns are too wide */
-  int allocated_(inner_space_ + fixed_sum_);
-  if(allocated_ + var_count_ > width_)
-    throw TypoError("cannot solve column widths");
-  if(allocated_ + var_count_ > next_width_)
-    throw TypoError("cannot solve column widths for next line");
+  if(fixed_space + auto_count_ + var_count > width_)
+    return false;
 
-  /* -- solve variable widths */
-  int var_space_(width_ - allocated_);
-  int var_space_next_(next_width_ - allocated_);
-  int var_width_(0);
-  int var_width_next_(0);
-  if(var_count_ > 0) {
-    var_width_ = var_space_ / var_count_;
-    var_width_next_ = var_space_next_ / var_count_;
-    allocated_ = width_;
+  /* -- The auto columns get their maximal widths if they fit beside
+   *    the minimal widths of the variable columns. Otherwise they are
+   *    shrunk in proportion to the difference of their maximal and
+   *    minimal widths. The variable columns share the rest.
+   *
+   *    If even the minimal widths don't fit, the auto columns get
+   *    a share of the space in proportion to their minimal widths
+   *    (at least one character each) and the long words are broken. */
+  int space_(width_ - fixed_space);
+  const bool fit_(auto_max_ + var_reserve <= space_);
+  const bool shrink_(auto_min_ + var_reserve > space_);
+  const long long extra_(
+      std::max(space_ - var_reserve - auto_min_, 0LL));
+  const long long demand_(auto_max_ - auto_min_);
+  long long shrunk_extra_(0);
+  const long long shrunk_demand_(auto_min_ - auto_count_);
+  if(shrink_) {
+    const long long auto_space_(std::min<long long>(
+        space_ * auto_min_ / (auto_min_ + var_reserve),
+        space_ - var_count));
+    shrunk_extra_ = std::max<long long>(auto_space_ - auto_count_, 0);
   }
-
-  margin_ = 0;
-  bool var_first_(true);
-  for(int i_(0); i_ < columns.size(); ++i_) {
-    /* -- left margin */
-    auto block_margin_(columns[i_].block->getMargin());
-    if(i_ > 0) {
-      if(block_margin_.left > margin_)
-        margin_ = block_margin_.left;
-      driver_.skipChars(margin_);
+  for(int i_(0); i_ < count_; ++i_) {
+    if(columns[i_].width == WIDTH_AUTO) {
+      const Measure& measure_(measures[i_]);
+      if(fit_)
+        widths_[i_] = measure_.max;
+      else if(shrink_)
+        widths_[i_] = 1 + ((shrunk_demand_ > 0)
+            ? (measure_.min - 1) * shrunk_extra_ / shrunk_demand_ : 0);
+      else if(extra_ == 0)
+        widths_[i_] = measure_.min;
+      else
+        widths_[i_] = measure_.min
+            + (measure_.max - measure_.min) * extra_ / demand_;
+      space_ -= widths_[i_];
     }
-
-    /* -- print the text */
-    int col_width_(columns[i_].width);
-    int col_width_next_(col_width_);
-    if(col_width_ <= 0) {
-      if(var_first_) {
-        /* -- correction of integer rounding */
-        col_width_ = var_space_ - (var_count_ - 1) * var_width_;
-        col_width_next_ = var_space_next_ - (var_count_ - 1) * var_width_next_;
-        var_first_ = false;
+    else if(columns[i_].width > 0)
+      widths_[i_] = columns[i_].width;
+  }
+  if(!fit_ && var_count == 0) {
+    /* -- correction of integer rounding */
+    for(int i_(0); i_ < count_ && space_ > 0; ++i_) {
+      if(columns[i_].width == WIDTH_AUTO && widths_[i_] < measures[i_].max) {
+        ++widths_[i_];
+        --space_;
       }
-      else {
-        col_width_ = var_width_;
-        col_width_next_ = var_width_next_;
+    }
+  }
+
+  /* -- solve variable widths */
+  allocated_ = width_ - space_;
+  if(var_count > 0) {
+    const int var_width_(space_ / var_count);
+    bool var_first_(true);
+    for(int i_(0); i_ < count_; ++i_) {
+      if(columns[i_].width <= 0 && columns[i_].width != WIDTH_AUTO) {
+        if(var_first_) {
+          /* -- correction of integer rounding */
+          widths_[i_] = space_ - (var_count - 1) * var_width_;
+          var_first_ = false;
+        }
+        else
+          widths_[i_] = var_width_;
       }
     }
-    columns[i_].block->writeLine(
-        driver_, col_width_, col_width_next_, origin_);
+    allocated_ = width_;
+  }
 
-    /* -- prepare next margin */
-    margin_ = block_margin_.right;
+  return true;
+}
+
+int TypographBlockCols::solveWidths(
+    int width_,
+    int next_width_) {
+  prepareGeometry();
+  if(solved && width_ == solved_width && next_width_ == solved_next_width)
+    return solved_allocated;
+
+  solved = false;
+  int allocated_;
+  int next_allocated_;
+  if(!distributeWidths(width_, widths, allocated_))
+    throw TypoError("cannot solve column widths");
+  if(!distributeWidths(next_width_, next_widths, next_allocated_))
+    throw TypoError("cannot solve column widths for next line");
+
+  solved = true;
+  solved_width = width_;
+  solved_next_width = next_width_;
+  solved_allocated = allocated_;
+  return allocated_;
+}
+
+void TypographBlockCols::layoutColumns(
+    const TypographState& origin_) {
+  /* -- The first line of a column gets the solved widths, all next lines
+   *    get the next widths as the width of next lines doesn't change. */
+  tapes.resize(columns.size());
+  runTasks(
+      [this, &origin_](int column_) {
+        ColumnTape& tape_(tapes[column_]);
+        tape_.tape.reset(new LineDriverTape);
+        tape_.lines.clear();
+        TypographBlock* block_(columns[column_].block);
+        int width_(widths[column_]);
+        while(!block_->isFinished()) {
+          block_->writeLine(
+              *tape_.tape, width_, next_widths[column_], origin_);
+          tape_.lines.push_back(tape_.tape->getPosition());
+          width_ = next_widths[column_];
+        }
+      },
+      columns.size(),
+      threads);
+
+  line_count = 0;
+  for(const auto& tape_ : tapes)
+    line_count = std::max(line_count, static_cast<int>(tape_.lines.size()));
+}
+
+void TypographBlockCols::writeColumn(
+    int column_,
+    LineDriver& driver_,
+    const TypographState& origin_) {
+  if(!laid_out) {
+    columns[column_].block->writeLine(
+        driver_, widths[column_], next_widths[column_], origin_);
+    return;
+  }
+
+  const ColumnTape& tape_(tapes[column_]);
+  if(current_line < static_cast<int>(tape_.lines.size())) {
+    tape_.tape->replay(
+        driver_,
+        (current_line > 0) ? tape_.lines[current_line - 1] : 0,
+        tape_.lines[current_line]);
+  }
+  else {
+    /* -- the column is finished, let it fill the line */
+    columns[column_].block->writeLine(
+        driver_, widths[column_], next_widths[column_], origin_);
+  }
+}
+
+void TypographBlockCols::releaseTapes() noexcept {
+  tapes.clear();
+}
+
+void TypographBlockCols::writeLine(
+    LineDriver& driver_,
+    int width_,
+    int next_width_,
+    const TypographState& origin_) {
+  if(laid_out
+      && (width_ != layout_width
+          || next_width_ != layout_width
+          || origin_ != layout_origin)) {
+    throw TypoError("width of the concurrent columns is not stable");
+  }
+
+  const int allocated_(solveWidths(width_, next_width_));
+
+  if(concurrent && !laid_out) {
+    layoutColumns(origin_);
+    laid_out = true;
+    current_line = 0;
+    layout_width = next_width_;
+    layout_origin = origin_;
+  }
+
+  const int count_(columns.size());
+  for(int i_(0); i_ < count_; ++i_) {
+    /* -- space between the columns */
+    if(i_ > 0)
+      driver_.skipChars(gaps[i_]);
+
+    /* -- print the text */
+    writeColumn(i_, driver_, origin_);
   }
 
   if(allocated_ < width_)
     driver_.skipChars(width_ - allocated_);
+
+  if(laid_out && ++current_line >= line_count)
+    releaseTapes();
 }
 
 bool TypographBlockCols::isFinished() const noexcept {
+  if(laid_out)
+    return current_line >= line_count;
   return std::all_of(
       columns.begin(),
       columns.end(),
@@ -143,6 +348,49 @@ TypographBlockCols::Border TypographBlockCols::getMargin() const noexcept {
   return {left_, top_, right_, bottom_};
 }
 
+void TypographBlockCols::reset() noexcept {
+  geometry_ready = false;
+  solved = false;
+  laid_out = false;
+  current_line = 0;
+  line_count = 0;
+  releaseTapes();
+  for(auto& column_ : columns)
+    column_.block->reset();
+}
+
+TypographBlockCols::Measure TypographBlockCols::measure() const noexcept {
+  long long min_(0);
+  long long max_(0);
+  int margin_(0);
+  const int count_(columns.size());
+  for(int i_(0); i_ < count_; ++i_) {
+    auto block_margin_(columns[i_].block->getMargin());
+    if(i_ > 0) {
+      const int gap_(std::max(margin_, block_margin_.left));
+      min_ += gap_;
+      max_ += gap_;
+    }
+    margin_ = block_margin_.right;
+
+    if(columns[i_].width > 0) {
+      min_ += columns[i_].width;
+      max_ += columns[i_].width;
+    }
+    else {
+      const auto measure_(columns[i_].block->measure());
+      const int column_min_(std::max(measure_.min, 1));
+      min_ += column_min_;
+      max_ += std::max(measure_.max, column_min_);
+    }
+  }
+
+  const long long limit_(std::numeric_limits<int>::max());
+  return {
+      static_cast<int>(std::min(min_, limit_)),
+      static_cast<int>(std::min(max_, limit_))};
+}
+
 } /* -- namespace Typograph */
 
 } /* -- namespace OndraRT */
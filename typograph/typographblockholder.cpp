@@ -22,6 +22,8 @@
 #include <utility>
 
 #include "typographblock.h"
+#include "typographblocktext.h"
+#include "typolayout.h"
 
 namespace OndraRT {
 
@@ -32,7 +34,7 @@ TypographBlockHolder::TypographBlockHolder() {
 }
 
 TypographBlockHolder::~TypographBlockHolder() {
-
+  reset();
 }
 
 TypographBlock* TypographBlockHolder::holdBlock(
@@ -41,6 +43,24 @@ TypographBlock* TypographBlockHolder::holdBlock(
   return blocks.back().get();
 }
 
+std::shared_ptr<const TypoLayout> TypographBlockHolder::createLayout(
+    const char* text_) {
+  return std::allocate_shared<TypoLayout>(
+      TypographArenaAllocator<TypoLayout>(&arena), text_, &arena);
+}
+
+TypographBlockText* TypographBlockHolder::createText(
+    const std::string& text_) {
+  return createBlock<TypographBlockText>(createLayout(text_.c_str()));
+}
+
+void TypographBlockHolder::reset() noexcept {
+  /* -- the blocks may keep the layouts, hence they are destroyed before
+   *    the rest of the arena */
+  blocks.clear();
+  arena.reset();
+}
+
 } /* -- namespace Typograph */
 
 } /* -- namespace OndraRT */
@@ -19,6 +19,7 @@
 
 #include "typographblockpar.h"
 
+#include <algorithm>
 #include "assert.h"
 
 #include "linedriver.h"
@@ -82,6 +83,19 @@ TypographBlockPar::Border TypographBlockPar::getMargin() const noexcept {
   return {0, 0, 0, 0};
 }
 
+void TypographBlockPar::reset() noexcept {
+  first_line = true;
+  block->reset();
+}
+
+
+TypographBlockPar::Measure TypographBlockPar::measure() const noexcept {
+  /* -- The minimal width may exceed the maximal one if the next lines
+   *    are indented more than the first one. */
+  const auto measure_(block->measure());
+  const int min_(measure_.min + std::max(first_indent, indent));
+  return {min_, std::max(measure_.max + first_indent, min_)};
+}
 
 } /* -- namespace Typograph */
 
@@ -19,6 +19,7 @@
 
 #include "typographblockseq.h"
 
+#include <algorithm>
 #include <assert.h>
 
 #include "linedriver.h"
@@ -93,6 +94,23 @@ TypographBlockSeq::Border TypographBlockSeq::getMargin() const noexcept {
   return {left_, top_, right_, bottom_};
 }
 
+void TypographBlockSeq::reset() noexcept {
+  current_block = 0;
+  current_space = 0;
+  for(int i_(0); i_ < blocks_num; ++i_)
+    blocks[i_]->reset();
+}
+
+TypographBlockSeq::Measure TypographBlockSeq::measure() const noexcept {
+  Measure measure_{0, 0};
+  for(int i_(0); i_ < blocks_num; ++i_) {
+    const auto block_measure_(blocks[i_]->measure());
+    measure_.min = std::max(measure_.min, block_measure_.min);
+    measure_.max = std::max(measure_.max, block_measure_.max);
+  }
+  return measure_;
+}
+
 } /* -- namespace Typograph */
 
 } /* -- namespace OndraRT */
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "typographblocktable.h"
+
+#include <algorithm>
+#include <assert.h>
+
+#include "linedriver.h"
+#include "typographblockcols.h"
+#include "typographblocktext.h"
+#include "typographrowsource.h"
+
+namespace OndraRT {
+
+namespace Typograph {
+
+/**
+ * @brief A column of the table showing the cell of the current row
+ */
+class TypographBlockTable::Cell : public TypographBlock {
+  public:
+    Cell() :
+      block(nullptr),
+      gap(0),
+      sampled{1, 1} {
+
+    }
+
+    virtual void writeLine(
+        LineDriver& driver_,
+        int width_,
+        int next_width_,
+        const TypographState& origin_) override {
+      if(block != nullptr)
+        block->writeLine(driver_, width_, next_width_, origin_);
+      else
+        driver_.skipChars(width_);
+    }
+
+    virtual bool isFinished() const noexcept override {
+      return block == nullptr || block->isFinished();
+    }
+
+    virtual Border getMargin() const noexcept override {
+      return {gap, 0, 0, 0};
+    }
+
+    virtual void reset() noexcept override {
+      if(block != nullptr)
+        block->reset();
+    }
+
+    virtual Measure measure() const noexcept override {
+      return sampled;
+    }
+
+    TypographBlock* block;
+    int gap;
+    Measure sampled;
+};
+
+TypographBlockTable::TypographBlockTable(
+    TypographRowSource* source_,
+    const int* widths_,
+    int colsnum_) :
+  source(source_),
+  colsnum(colsnum_),
+  cells(new Cell[colsnum_]),
+  cols(),
+  sample_limit(100),
+  sample(),
+  sample_count(0),
+  sample_next(0),
+  sampled(false),
+  exhausted(false),
+  rewind(false),
+  started(false),
+  finished(false),
+  holder() {
+  assert(source != nullptr && widths_ != nullptr && colsnum > 0);
+
+  std::vector<TypographBlockCols::Column> columns_;
+  for(int i_(0); i_ < colsnum; ++i_) {
+    cells[i_].gap = (i_ > 0) ? 1 : 0;
+    columns_.push_back({&cells[i_], widths_[i_]});
+  }
+  cols.reset(new TypographBlockCols(columns_.data(), colsnum));
+}
+
+TypographBlockTable::~TypographBlockTable() {
+
+}
+
+void TypographBlockTable::setGap(
+    int gap_) {
+  for(int i_(1); i_ < colsnum; ++i_)
+    cells[i_].gap = gap_;
+  cols->reset();
+}
+
+void TypographBlockTable::setSampleRows(
+    int rows_) {
+  sample_limit = rows_;
+}
+
+void TypographBlockTable::sampleRows() const {
+  if(rewind) {
+    source->rewind();
+    rewind = false;
+  }
+
+  for(int i_(0); i_ < colsnum; ++i_)
+    cells[i_].sampled = {0, 0};
+
+  /* -- The sampled rows are kept as they cannot be read from the source
+   *    again. Only the layouts of one row are kept at a time. */
+  sample_count = 0;
+  try {
+    while(sample_count < sample_limit) {
+      if(!source->nextRow()) {
+        exhausted = true;
+        break;
+      }
+      const std::size_t first_(sample_count * colsnum);
+      if(sample.size() < first_ + colsnum)
+        sample.resize(first_ + colsnum);
+      for(int i_(0); i_ < colsnum; ++i_) {
+        std::string& text_(sample[first_ + i_]);
+        text_.assign(source->getCell(i_));
+        auto* block_(holder.createBlock<TypographBlockText>(
+            holder.createLayout(text_.c_str())));
+        const Measure measure_(block_->measure());
+        Measure& sampled_(cells[i_].sampled);
+        sampled_.min = std::max(sampled_.min, measure_.min);
+        sampled_.max = std::max(sampled_.max, measure_.max);
+      }
+      holder.reset();
+      ++sample_count;
+    }
+  }
+  catch(...) {
+    /* -- the rows are read again by next sampling */
+    holder.reset();
+    sample_count = 0;
+    exhausted = false;
+    rewind = true;
+    throw;
+  }
+
+  /* -- let the columns solve their widths with the sampled measures */
+  cols->reset();
+  sampled = true;
+}
+
+bool TypographBlockTable::loadRow() {
+  holder.reset();
+  for(int i_(0); i_ < colsnum; ++i_)
+    cells[i_].block = nullptr;
+
+  /* -- the sampled rows go first */
+  if(sample_next < sample_count) {
+    const std::size_t first_(sample_next * colsnum);
+    for(int i_(0); i_ < colsnum; ++i_) {
+      cells[i_].block = holder.createBlock<TypographBlockText>(
+          holder.createLayout(sample[first_ + i_].c_str()));
+    }
+    ++sample_next;
+    return true;
+  }
+
+  if(exhausted || !source->nextRow()) {
+    exhausted = true;
+    return false;
+  }
+  for(int i_(0); i_ < colsnum; ++i_) {
+    cells[i_].block = holder.createBlock<TypographBlockText>(
+        holder.createLayout(source->getCell(i_)));
+  }
+  return true;
+}
+
+void TypographBlockTable::writeLine(
+    LineDriver& driver_,
+    int width_,
+    int next_width_,
+    const TypographState& origin_) {
+  if(!started) {
+    if(!sampled)
+      sampleRows();
+    sample_next = 0;
+    finished = !loadRow();
+    started = true;
+  }
+
+  /* -- the table is empty or finished */
+  if(finished) {
+    driver_.skipChars(width_);
+    return;
+  }
+
+  cols->writeLine(driver_, width_, next_width_, origin_);
+
+  /* -- Load next row right after the current one is finished, so that
+   *    the table knows whether it's finished. */
+  if(cols->isFinished())
+    finished = !loadRow();
+}
+
+bool TypographBlockTable::isFinished() const noexcept {
+  return finished;
+}
+
+TypographBlockTable::Border TypographBlockTable::getMargin() const noexcept {
+  return {0, 0, 0, 0};
+}
+
+void TypographBlockTable::reset() noexcept {
+  holder.reset();
+  for(int i_(0); i_ < colsnum; ++i_)
+    cells[i_].block = nullptr;
+  cols->reset();
+  sample_count = 0;
+  sample_next = 0;
+  sampled = false;
+  exhausted = false;
+  rewind = true;
+  started = false;
+  finished = false;
+}
+
+TypographBlockTable::Measure TypographBlockTable::measure() const noexcept {
+  /* -- the auto columns need the measures of the sampled rows */
+  if(!sampled) {
+    try {
+      sampleRows();
+    }
+    catch(...) {
+      /* -- the error is reported when the table is printed */
+    }
+  }
+  return cols->measure();
+}
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
@@ -19,7 +19,9 @@
 
 #include "typographblocktext.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <limits>
 #include <utility>
 
 #include "linedriver.h"
@@ -30,28 +32,27 @@ namespace Typograph {
 
 TypographBlockText::TypographBlockText(
     const std::string& text_) :
-  text(text_),
-  tokenizer(text.c_str()),
-  state(),
-  remained_out(0),
-  remained_word(),
-  prepared_index(0),
-  prepared(),
-  finished(false) {
+  TypographBlockText(std::make_shared<TypoLayout>(text_)) {
 
 }
 
-
 TypographBlockText::TypographBlockText(
     std::string&& text_) :
-  text(std::move(text_)),
-  tokenizer(text.c_str()),
+  TypographBlockText(std::make_shared<TypoLayout>(text_)) {
+
+}
+
+TypographBlockText::TypographBlockText(
+    std::shared_ptr<const TypoLayout> layout_) :
+  layout(std::move(layout_)),
   state(),
-  remained_out(0),
-  remained_word(),
+  next_word(0),
+  prepared_word(-1),
   prepared_index(0),
-  prepared(),
+  remained_out(0),
+  token_out(0),
   finished(false) {
+  assert(layout != nullptr);
 
 }
 
@@ -67,23 +68,27 @@ void TypographBlockText::flushPrepared(
     int& line_fill_,
     bool line_begin_) {
   /* -- there's nothing to do */
-  if(prepared.empty())
+  if(prepared_word < 0)
     return;
 
   /* -- Check whether the word can be written on this line. If it can,
    *    continue to print it. If it cannot, check whether it can be
    *    printed at next line. If it can, break current line. */
+  const TypoLayout::Word& word_(layout->getWord(prepared_word));
+  const std::size_t word_width_(width_);
+  const std::size_t word_next_width_(next_width_);
   if(!line_begin_
       && remained_out == 0
-      && line_fill_ + remained_word.length() > width_
-      && remained_word.length() < next_width_) {
+      && line_fill_ + word_.length > word_width_
+      && word_.length < word_next_width_) {
     driver_.skipChars(width_ - line_fill_);
     line_fill_ = width_;
     return;
   }
 
-  while(prepared_index < prepared.size()) {
-    auto& token_(prepared[prepared_index]);
+  const char* text_(layout->getText(word_));
+  while(prepared_index < word_.end_token) {
+    const auto& token_(layout->getToken(prepared_index));
     switch(token_.type) {
       case TypoTokenizer::FONT_STYLE:
         state_.setFontStyle(token_.font_style);
@@ -102,39 +107,43 @@ void TypographBlockText::flushPrepared(
         ++prepared_index;
         break;
       case TypoTokenizer::TEXT: {
-        if(line_fill_ + token_.length <= width_) {
+        const int length_(token_.length - token_out);
+        if(line_fill_ + length_ <= width_) {
           /* -- There is enough space, print the word */
-          driver_.writeText(
-              remained_word.c_str() + remained_out, token_.length);
+          driver_.writeText(text_ + remained_out, length_);
           ++prepared_index;
-          remained_out += token_.length;
-          line_fill_ += token_.length;
+          token_out = 0;
+          remained_out += length_;
+          line_fill_ += length_;
         }
         else {
           /* -- not enough space */
           int rest_(width_ - line_fill_);
           /* -- break the word */
-          driver_.writeText(remained_word.c_str() + remained_out, rest_);
+          driver_.writeText(text_ + remained_out, rest_);
           remained_out += rest_;
-          token_.length -= rest_;
+          token_out += rest_;
           line_fill_ = width_;
           return;
         }
       }
       break;
+      default:
+        assert(false);
+        ++prepared_index;
+        break;
     }
   }
 
   /* -- prepare the space after the word */
-  if(!prepared.empty() && line_fill_ < width_) {
+  if(line_fill_ < width_) {
     driver_.skipChars(1);
     ++line_fill_;
   }
 
+  prepared_word = -1;
   remained_out = 0;
-  remained_word.clear();
-  prepared_index = 0;
-  prepared.clear();
+  token_out = 0;
 }
 
 void TypographBlockText::writeLine(
@@ -155,44 +164,59 @@ void TypographBlockText::writeLine(
   int line_fill_(0);
   flushPrepared(driver_, width_, next_width_, state_, line_fill_, true);
 
-  /* -- parse stored text */
+  /* -- print next words */
   while(line_fill_ < width_) {
-    TypoTokenizer::Token token_(tokenizer.nextToken());
-    switch(token_.type) {
-      case TypoTokenizer::FONT_STYLE:
-      case TypoTokenizer::FONT_WEIGHT:
-      case TypoTokenizer::FOREGROUND:
-      case TypoTokenizer::BACKGROUND:
-        prepared.push_back(token_);
-        break;
-      case TypoTokenizer::TEXT:
-        remained_word += token_.text;
-        prepared.push_back(token_);
-        break;
-      case TypoTokenizer::END_OF_TEXT:
-        finished = true;
-        flushPrepared(driver_, width_, next_width_, state_, line_fill_, false);
-        driver_.skipChars(width_ - line_fill_);
-        line_fill_ = width_;
-        break;
-      case TypoTokenizer::SPACE:
-        flushPrepared(driver_, width_, next_width_, state_, line_fill_, false);
-        break;
-      default:
-        assert(false);
-        break;
+    if(next_word < layout->getWordCount()) {
+      prepared_word = next_word++;
+      prepared_index = layout->getWord(prepared_word).first_token;
+      const bool last_(layout->getWord(prepared_word).last);
+      flushPrepared(driver_, width_, next_width_, state_, line_fill_, false);
+      if(!last_)
+        continue;
     }
+
+    /* -- end of the text */
+    finished = true;
+    driver_.skipChars(width_ - line_fill_);
+    line_fill_ = width_;
   }
 }
 
 bool TypographBlockText::isFinished() const noexcept {
-  return finished && prepared.empty();
+  return finished && prepared_word < 0;
 }
 
 TypographBlockText::Border TypographBlockText::getMargin() const noexcept {
   return {0, 0, 0, 0};
 }
 
+void TypographBlockText::reset() noexcept {
+  state = TypographState();
+  next_word = 0;
+  prepared_word = -1;
+  prepared_index = 0;
+  remained_out = 0;
+  token_out = 0;
+  finished = false;
+}
+
+TypographBlockText::Measure TypographBlockText::measure() const noexcept {
+  /* -- the words are separated by one space */
+  std::size_t min_(0);
+  std::size_t max_(0);
+  const int count_(layout->getWordCount());
+  for(int i_(0); i_ < count_; ++i_) {
+    const std::size_t length_(layout->getWord(i_).length);
+    min_ = std::max(min_, length_);
+    max_ += length_ + ((i_ > 0) ? 1 : 0);
+  }
+
+  const std::size_t limit_(std::numeric_limits<int>::max());
+  return {
+      static_cast<int>(std::min(min_, limit_)),
+      static_cast<int>(std::min(max_, limit_))};
+}
+
 } /* -- namespace Typograph */
 
 } /* -- namespace OndraRT */
@@ -76,6 +76,19 @@ TypographState& TypographState::operator =(
   return *this;
 }
 
+bool TypographState::operator ==(
+    const TypographState& other_) const noexcept {
+  return font_style == other_.font_style
+      && font_weight == other_.font_weight
+      && foreground == other_.foreground
+      && background == other_.background;
+}
+
+bool TypographState::operator !=(
+    const TypographState& other_) const noexcept {
+  return !(*this == other_);
+}
+
 TypographStateScope::TypographStateScope(
     LineDriver* driver_,
     const TypographState* origin_,
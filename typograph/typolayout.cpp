@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "typolayout.h"
+
+#include <assert.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "typographarena.h"
+
+namespace OndraRT {
+
+namespace Typograph {
+
+namespace {
+
+/* -- Largest capacity of a parse buffer kept for next parsing */
+constexpr std::size_t PARSE_BUFFER_KEPT(64 * 1024);
+
+template<typename Buffer_>
+void trimBuffer(
+    Buffer_& buffer_) noexcept {
+  if(buffer_.capacity() * sizeof(typename Buffer_::value_type)
+      > PARSE_BUFFER_KEPT) {
+    Buffer_().swap(buffer_);
+  }
+}
+
+/* -- The parsed text is collected in these buffers and then it's copied
+ *    into the final storage. The buffers are kept for next parsing, so
+ *    the parsing of common texts doesn't allocate memory in the steady
+ *    state. Buffers grown by a large text are released after the parsing,
+ *    so the threads don't keep memory of the largest text they have ever
+ *    parsed. */
+struct ParseBuffers {
+  std::string chars;
+  std::vector<TypoTokenizer::Token> tokens;
+  std::vector<TypoLayout::Word> words;
+
+  void trim() noexcept {
+    trimBuffer(chars);
+    trimBuffer(tokens);
+    trimBuffer(words);
+  }
+};
+
+/* -- trim the buffers when the parsing ends (even by an exception) */
+class ParseBuffersTrimmer {
+  private:
+    ParseBuffers* buffers;
+
+  public:
+    explicit ParseBuffersTrimmer(
+        ParseBuffers* buffers_) :
+      buffers(buffers_) {
+
+    }
+
+    ~ParseBuffersTrimmer() {
+      buffers->trim();
+    }
+
+    /* -- avoid copying */
+    ParseBuffersTrimmer(
+        const ParseBuffersTrimmer&) = delete;
+    ParseBuffersTrimmer& operator =(
+        const ParseBuffersTrimmer&) = delete;
+};
+
+std::size_t alignOffset(
+    std::size_t offset_,
+    std::size_t align_) noexcept {
+  return (offset_ + align_ - 1) / align_ * align_;
+}
+
+} /* -- namespace */
+
+TypoLayout::TypoLayout(
+    const char* text_) :
+  storage(),
+  words(nullptr),
+  word_count(0),
+  tokens(nullptr),
+  token_count(0),
+  chars(nullptr) {
+  parse(text_, nullptr);
+}
+
+TypoLayout::TypoLayout(
+    const std::string& text_) :
+  storage(),
+  words(nullptr),
+  word_count(0),
+  tokens(nullptr),
+  token_count(0),
+  chars(nullptr) {
+  parse(text_.c_str(), nullptr);
+}
+
+TypoLayout::TypoLayout(
+    const char* text_,
+    TypographArena* arena_) :
+  storage(),
+  words(nullptr),
+  word_count(0),
+  tokens(nullptr),
+  token_count(0),
+  chars(nullptr) {
+  assert(arena_ != nullptr);
+  parse(text_, arena_);
+}
+
+TypoLayout::~TypoLayout() {
+
+}
+
+void TypoLayout::parse(
+    const char* text_,
+    TypographArena* arena_) {
+  static thread_local ParseBuffers buffers_;
+  ParseBuffersTrimmer trimmer_(&buffers_);
+  std::string& chars_(buffers_.chars);
+  std::vector<TypoTokenizer::Token>& tokens_(buffers_.tokens);
+  std::vector<Word>& words_(buffers_.words);
+  chars_.clear();
+  tokens_.clear();
+  words_.clear();
+
+  TypoTokenizer tokenizer_(text_);
+
+  Word word_{0, 0, 0, 0, false};
+  bool end_(false);
+  while(!end_) {
+    TypoTokenizer::Token token_(tokenizer_.nextToken());
+    switch(token_.type) {
+      case TypoTokenizer::FONT_STYLE:
+      case TypoTokenizer::FONT_WEIGHT:
+      case TypoTokenizer::FOREGROUND:
+      case TypoTokenizer::BACKGROUND:
+        tokens_.push_back(token_);
+        break;
+      case TypoTokenizer::TEXT:
+        chars_.append(token_.text, token_.length);
+        tokens_.push_back(token_);
+        break;
+      case TypoTokenizer::END_OF_TEXT:
+        end_ = true;
+        /* fall through */
+      case TypoTokenizer::SPACE:
+        /* -- close current word, empty words are not stored */
+        if(static_cast<std::size_t>(word_.first_token) < tokens_.size()) {
+          word_.end_token = tokens_.size();
+          word_.length = chars_.size() - word_.offset;
+          word_.last = end_;
+          words_.push_back(word_);
+        }
+        word_.first_token = tokens_.size();
+        word_.offset = chars_.size();
+        break;
+      default:
+        assert(false);
+        break;
+    }
+  }
+
+  /* -- allocate the storage */
+  const std::size_t tokens_offset_(alignOffset(
+      words_.size() * sizeof(Word), alignof(TypoTokenizer::Token)));
+  const std::size_t chars_offset_(
+      tokens_offset_ + tokens_.size() * sizeof(TypoTokenizer::Token));
+  const std::size_t size_(chars_offset_ + chars_.size());
+  char* memory_;
+  if(arena_ != nullptr)
+    memory_ = static_cast<char*>(arena_->allocate(size_, alignof(Word)));
+  else {
+    storage.reset(new char[size_]);
+    memory_ = storage.get();
+  }
+
+  /* -- copy the parsed text, the text tokens point into the stored
+   *    characters */
+  Word* words_storage_(reinterpret_cast<Word*>(memory_));
+  std::uninitialized_copy(words_.begin(), words_.end(), words_storage_);
+  TypoTokenizer::Token* tokens_storage_(
+      reinterpret_cast<TypoTokenizer::Token*>(memory_ + tokens_offset_));
+  std::uninitialized_copy(tokens_.begin(), tokens_.end(), tokens_storage_);
+  char* chars_storage_(memory_ + chars_offset_);
+  std::memcpy(chars_storage_, chars_.data(), chars_.size());
+
+  std::size_t offset_(0);
+  for(std::size_t i_(0); i_ < tokens_.size(); ++i_) {
+    if(tokens_storage_[i_].type == TypoTokenizer::TEXT) {
+      tokens_storage_[i_].text = chars_storage_ + offset_;
+      offset_ += tokens_storage_[i_].length;
+    }
+  }
+
+  words = words_storage_;
+  word_count = words_.size();
+  tokens = tokens_storage_;
+  token_count = tokens_.size();
+  chars = chars_storage_;
+}
+
+int TypoLayout::getWordCount() const noexcept {
+  return word_count;
+}
+
+const TypoLayout::Word& TypoLayout::getWord(
+    int index_) const noexcept {
+  assert(index_ >= 0 && index_ < word_count);
+  return words[index_];
+}
+
+const TypoTokenizer::Token& TypoLayout::getToken(
+    int index_) const noexcept {
+  assert(index_ >= 0 && index_ < token_count);
+  return tokens[index_];
+}
+
+const char* TypoLayout::getText(
+    const Word& word_) const noexcept {
+  return chars + word_.offset;
+}
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
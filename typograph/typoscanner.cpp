@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "typoscanner.h"
+
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ONDRART_TYPOGRAPH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace OndraRT {
+
+namespace Typograph {
+
+namespace Scanner {
+
+namespace {
+
+typedef const char* (*FindFunc)(const char*);
+
+const char* findScalar(
+    const char* text_) {
+  while(!isSpecial(*text_))
+    ++text_;
+  return text_;
+}
+
+#if defined(ONDRART_TYPOGRAPH_X86)
+
+/* -- The vector scanners load aligned blocks. The bytes of the first
+ *    block preceding the text are masked out. The reads behind
+ *    the terminating zero stay in the same aligned block, hence they
+ *    are safe, but the address sanitizer would report them. */
+
+__attribute__((target("sse2"), no_sanitize_address))
+int specialMask128(
+    __m128i in_) {
+  /* -- the whitespaces \t - \r make a continuous range */
+  const __m128i shifted_(_mm_sub_epi8(in_, _mm_set1_epi8('\t')));
+  const __m128i range_(_mm_cmpeq_epi8(
+      _mm_min_epu8(shifted_, _mm_set1_epi8('\r' - '\t')), shifted_));
+  const __m128i special_(_mm_or_si128(
+      _mm_or_si128(
+          _mm_cmpeq_epi8(in_, _mm_setzero_si128()),
+          _mm_cmpeq_epi8(in_, _mm_set1_epi8(' '))),
+      _mm_or_si128(
+          _mm_or_si128(
+              _mm_cmpeq_epi8(in_, _mm_set1_epi8('*')),
+              _mm_cmpeq_epi8(in_, _mm_set1_epi8('#'))),
+          _mm_cmpeq_epi8(in_, _mm_set1_epi8('\\')))));
+  return _mm_movemask_epi8(_mm_or_si128(special_, range_));
+}
+
+__attribute__((target("sse2"), no_sanitize_address))
+const char* findSse2(
+    const char* text_) {
+  const std::uintptr_t offset_(reinterpret_cast<std::uintptr_t>(text_) & 15);
+  const char* block_(text_ - offset_);
+  unsigned int mask_(specialMask128(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(block_))) >> offset_);
+  if(mask_ != 0)
+    return text_ + __builtin_ctz(mask_);
+  while(true) {
+    block_ += 16;
+    mask_ = specialMask128(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(block_)));
+    if(mask_ != 0)
+      return block_ + __builtin_ctz(mask_);
+  }
+}
+
+__attribute__((target("avx2"), no_sanitize_address))
+unsigned int specialMask256(
+    __m256i in_) {
+  /* -- the whitespaces \t - \r make a continuous range */
+  const __m256i shifted_(_mm256_sub_epi8(in_, _mm256_set1_epi8('\t')));
+  const __m256i range_(_mm256_cmpeq_epi8(
+      _mm256_min_epu8(shifted_, _mm256_set1_epi8('\r' - '\t')), shifted_));
+  const __m256i special_(_mm256_or_si256(
+      _mm256_or_si256(
+          _mm256_cmpeq_epi8(in_, _mm256_setzero_si256()),
+          _mm256_cmpeq_epi8(in_, _mm256_set1_epi8(' '))),
+      _mm256_or_si256(
+          _mm256_or_si256(
+              _mm256_cmpeq_epi8(in_, _mm256_set1_epi8('*')),
+              _mm256_cmpeq_epi8(in_, _mm256_set1_epi8('#'))),
+          _mm256_cmpeq_epi8(in_, _mm256_set1_epi8('\\')))));
+  return _mm256_movemask_epi8(_mm256_or_si256(special_, range_));
+}
+
+__attribute__((target("avx2"), no_sanitize_address))
+const char* findAvx2(
+    const char* text_) {
+  const std::uintptr_t offset_(reinterpret_cast<std::uintptr_t>(text_) & 31);
+  const char* block_(text_ - offset_);
+  unsigned int mask_(specialMask256(
+      _mm256_load_si256(reinterpret_cast<const __m256i*>(block_))) >> offset_);
+  if(mask_ != 0)
+    return text_ + __builtin_ctz(mask_);
+  while(true) {
+    block_ += 32;
+    mask_ = specialMask256(
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(block_)));
+    if(mask_ != 0)
+      return block_ + __builtin_ctz(mask_);
+  }
+}
+
+FindFunc selectFinder() {
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2"))
+    return &findAvx2;
+  if(__builtin_cpu_supports("sse2"))
+    return &findSse2;
+  return &findScalar;
+}
+
+#else
+
+FindFunc selectFinder() {
+  return &findScalar;
+}
+
+#endif /* -- ONDRART_TYPOGRAPH_X86 */
+
+} /* -- namespace */
+
+const char* findSpecial(
+    const char* text_) noexcept {
+  static const FindFunc finder_(selectFinder());
+  return finder_(text_);
+}
+
+} /* -- namespace Scanner */
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
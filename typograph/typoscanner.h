@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__TYPOSCANNER_H_
+#define OndraRT__TYPOSCANNER_H_
+
+namespace OndraRT {
+
+namespace Typograph {
+
+namespace Scanner {
+
+/**
+ * @brief Check whether a character is a whitespace
+ *
+ * The function implements the ASCII (C locale) semantics of std::isspace:
+ * the space, \\t, \\n, \\v, \\f and \\r characters.
+ */
+inline bool isSpace(
+    char c_) noexcept {
+  return c_ == ' ' || static_cast<unsigned char>(c_ - '\t') <= '\r' - '\t';
+}
+
+/**
+ * @brief Check whether a character terminates a plain text run
+ *
+ * The special characters are whitespaces, the markup characters '*',
+ * '#', '\\' and the terminating zero.
+ */
+inline bool isSpecial(
+    char c_) noexcept {
+  return c_ == 0 || c_ == '*' || c_ == '#' || c_ == '\\' || isSpace(c_);
+}
+
+/**
+ * @brief Find first special character of a zero terminated text
+ *
+ * The function picks the fastest implementation supported by the running
+ * CPU (AVX2, SSE2 or the scalar one). The vector implementations read
+ * whole aligned blocks, so they never cross a page boundary behind
+ * the terminating zero.
+ *
+ * @param text_ The text
+ * @return Pointer to the first special character (see isSpecial()).
+ *     The terminating zero is returned at the latest.
+ */
+const char* findSpecial(
+    const char* text_) noexcept;
+
+} /* -- namespace Scanner */
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__TYPOSCANNER_H_ */
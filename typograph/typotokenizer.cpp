@@ -20,19 +20,33 @@
 #include "typotokenizer.h"
 
 #include <assert.h>
-#include <cctype>
+#include <cstring>
+#include <string>
 
 #include "typoerror.h"
+#include "typoscanner.h"
 
 namespace OndraRT {
 
 namespace Typograph {
 
+namespace {
+
+bool isKeyword(
+    const char* value_,
+    int length_,
+    const char* keyword_) {
+  return std::strncmp(value_, keyword_, length_) == 0
+      && keyword_[length_] == 0;
+}
+
+} /* -- namespace */
+
 TypoTokenizer::TypoTokenizer(
     const char* text_) :
   text(text_),
   current(text_),
-  buffer(),
+  scratch(),
   font_style(LineDriver::FS_DEFAULT),
   font_weight(LineDriver::FW_DEFAULT) {
   assert(text != nullptr && current != nullptr);
@@ -43,62 +57,79 @@ TypoTokenizer::~TypoTokenizer() {
 
 }
 
-TypoTokenizer::Token TypoTokenizer::finishBuffer() {
+TypoTokenizer::Token TypoTokenizer::finishText(
+    const char* begin_,
+    bool escaped_) {
   Token token_;
   token_.type = TEXT;
-  token_text = buffer.str();
-  buffer.str("");
-  token_.text = token_text.c_str();
-  token_.length = token_text.length();
+  if(escaped_) {
+    token_.text = scratch.data();
+    token_.length = scratch.size();
+  }
+  else {
+    token_.text = begin_;
+    token_.length = current - begin_;
+  }
   return token_;
 }
 
-TypoTokenizer::Token TypoTokenizer::handleTag() {
+TypoTokenizer::Token TypoTokenizer::handleTag(
+    const char* name_,
+    int name_length_,
+    const char* value_,
+    int value_length_) {
   Token token_;
 
-  if(token_text == "fg") {
+  if(isKeyword(name_, name_length_, "fg")) {
     token_.type = FOREGROUND;
-    token_.color = parseColor(buffer.str());
+    token_.color = parseColor(value_, value_length_);
   }
-  else if(token_text == "bg") {
+  else if(isKeyword(name_, name_length_, "bg")) {
     token_.type = BACKGROUND;
-    token_.color = parseColor(buffer.str());
+    token_.color = parseColor(value_, value_length_);
   }
   else {
-    throw TypoError("invalid tag '" + token_text + "'");
+    throw TypoError("invalid tag '" + std::string(name_, name_length_) + "'");
   }
 
   return token_;
 }
 
 LineDriver::Color TypoTokenizer::parseColor(
-    const std::string& value_) {
-  if (value_ == "")
+    const char* value_,
+    int length_) {
+  if (length_ == 0)
     return LineDriver::C_DEFAULT;
-  if (value_ == "white")
+  if (isKeyword(value_, length_, "white"))
     return LineDriver::C_WHITE;
-  if (value_ == "black")
+  if (isKeyword(value_, length_, "black"))
     return LineDriver::C_BLACK;
-  if (value_ == "red")
+  if (isKeyword(value_, length_, "red"))
     return LineDriver::C_RED;
-  if (value_ == "green")
+  if (isKeyword(value_, length_, "green"))
     return LineDriver::C_GREEN;
-  if (value_ == "yellow")
+  if (isKeyword(value_, length_, "yellow"))
     return LineDriver::C_YELLOW;
-  if (value_ == "blue")
+  if (isKeyword(value_, length_, "blue"))
     return LineDriver::C_BLUE;
-  if (value_ == "magenta")
+  if (isKeyword(value_, length_, "magenta"))
     return LineDriver::C_MAGENTA;
-  if (value_ == "cyan")
+  if (isKeyword(value_, length_, "cyan"))
     return LineDriver::C_CYAN;
 
-  throw TypoError("invalid color value '" + value_ +"'");
+  throw TypoError(
+      "invalid color value '" + std::string(value_, length_) +"'");
 }
 
 TypoTokenizer::Token TypoTokenizer::nextToken() {
   Token token_;
 
-  buffer.str("");
+  /* -- Beginning of current word or tag. The words are sliced from
+   *    the text unless they contain an escape sequence. */
+  const char* begin_(nullptr);
+  bool escaped_(false);
+  const char* name_(nullptr);
+  int name_length_(0);
   enum State {
     S_BEGIN,
     S_SPACE,
@@ -118,20 +149,25 @@ TypoTokenizer::Token TypoTokenizer::nextToken() {
             token_.type = END_OF_TEXT;
             return token_;
           case '\\':
+            scratch.clear();
+            escaped_ = true;
             state_ = S_ESCAPED;
             break;
           case '*':
             state_ = S_ATTRIBUTE;
             break;
           case '#':
+            begin_ = current + 1;
             state_ = S_TAG;
             break;
           default:
-            if(std::isspace(*current)) {
+            if(Scanner::isSpace(*current)) {
               state_ = S_SPACE;
             }
             else {
-              buffer.put(*current);
+              /* -- skip the plain run of the word at once */
+              begin_ = current;
+              current = Scanner::findSpecial(current + 1) - 1;
               state_ = S_TEXT;
             }
             break;
@@ -144,7 +180,7 @@ TypoTokenizer::Token TypoTokenizer::nextToken() {
             token_.type = SPACE;
             return token_;
           default:
-            if(!std::isspace(*current)) {
+            if(!Scanner::isSpace(*current)) {
               token_.type = SPACE;
               return token_;
             }
@@ -157,15 +193,20 @@ TypoTokenizer::Token TypoTokenizer::nextToken() {
           case 0:
           case '*':
           case '#':
-            return finishBuffer();
+            return finishText(begin_, escaped_);
           case '\\':
+            /* -- move the word into the scratch buffer */
+            if(!escaped_) {
+              scratch.assign(begin_, current);
+              escaped_ = true;
+            }
             state_ = S_ESCAPED;
             break;
           default:
-            if(std::isspace(*current))
-              return finishBuffer();
-            else
-              buffer.put(*current);
+            if(Scanner::isSpace(*current))
+              return finishText(begin_, escaped_);
+            else if(escaped_)
+              scratch.push_back(*current);
             break;
         }
         break;
@@ -173,8 +214,14 @@ TypoTokenizer::Token TypoTokenizer::nextToken() {
       case S_ESCAPED:
         if(*current == 0)
           throw TypoError("escape sequence at the end of the string");
-        buffer.put(*current);
+        scratch.push_back(*current);
         state_ = S_TEXT;
+        /* -- copy the plain run following the escaped character at once */
+        {
+          const char* end_(Scanner::findSpecial(current + 1));
+          scratch.insert(scratch.end(), current + 1, end_);
+          current = end_ - 1;
+        }
         break;
 
       case S_ATTRIBUTE:
@@ -203,17 +250,18 @@ TypoTokenizer::Token TypoTokenizer::nextToken() {
           case 0:
             throw TypoError("invalid tag at the end of the string");
           case ':':
-            token_text = buffer.str();
-            buffer.str("");
+            name_ = begin_;
+            name_length_ = current - begin_;
+            begin_ = current + 1;
             state_ = S_VALUE;
             break;
           case '#':
-            token_text = buffer.str();
-            buffer.str("");
+            name_ = begin_;
+            name_length_ = current - begin_;
+            begin_ = current;
             state_ = S_TAG_END;
             break;
           default:
-            buffer.put(*current);
             break;
         }
         break;
@@ -226,13 +274,13 @@ TypoTokenizer::Token TypoTokenizer::nextToken() {
             state_ = S_TAG_END;
             break;
           default:
-            buffer.put(*current);
             break;
         }
         break;
 
       case S_TAG_END:
-        return handleTag();
+        /* -- the value ends before the closing '#' */
+        return handleTag(name_, name_length_, begin_, current - 1 - begin_);
     }
   }
 }
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "typoworkers.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+void runTasks(
+    const std::function<void(int)>& task_,
+    int count_,
+    int threads_) {
+  if(threads_ <= 0)
+    threads_ = std::thread::hardware_concurrency();
+  if(threads_ > count_)
+    threads_ = count_;
+  if(threads_ <= 1) {
+    for(int i_(0); i_ < count_; ++i_)
+      task_(i_);
+    return;
+  }
+
+  std::atomic<int> next_(0);
+  std::mutex mutex_;
+  std::exception_ptr error_;
+  auto work_([&]() {
+    for(int index_(next_.fetch_add(1));
+        index_ < count_;
+        index_ = next_.fetch_add(1)) {
+      try {
+        task_(index_);
+      }
+      catch(...) {
+        std::lock_guard<std::mutex> lock_(mutex_);
+        if(!error_)
+          error_ = std::current_exception();
+      }
+    }
+  });
+
+  std::vector<std::thread> workers_;
+  try {
+    for(int i_(1); i_ < threads_; ++i_)
+      workers_.emplace_back(work_);
+  }
+  catch(const std::system_error&) {
+    /* -- no more threads can be started, the running ones (including
+     *    the calling one) finish the batch */
+  }
+  work_();
+  for(auto& worker_ : workers_)
+    worker_.join();
+
+  if(error_)
+    std::rethrow_exception(error_);
+}
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
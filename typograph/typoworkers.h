@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__TYPOWORKERS_H_
+#define OndraRT__TYPOWORKERS_H_
+
+#include <functional>
+
+namespace OndraRT {
+
+namespace Typograph {
+
+/**
+ * @brief Run a batch of indexed tasks in parallel
+ *
+ * The function starts the worker threads for the batch only. The calling
+ * thread takes part in the work.
+ *
+ * @param task_ The task. It's invoked with indexes 0 .. @a count_ - 1.
+ * @param count_ Number of the tasks
+ * @param threads_ Number of threads working on the batch (including
+ *     the calling one). Zero or negative value means the number of
+ *     the CPU cores.
+ * @exception The first exception thrown by a task is rethrown after
+ *     all the threads finish.
+ */
+void runTasks(
+    const std::function<void(int)>& task_,
+    int count_,
+    int threads_);
+
+} /* -- namespace Typograph */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__TYPOWORKERS_H_ */
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "optionindex.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+
+namespace OndraRT {
+
+namespace Usage {
+
+namespace {
+
+constexpr const std::size_t INITIAL_SLOTS(16);
+
+} /* -- namespace */
+
+OptionIndex::OptionIndex() :
+  slots(INITIAL_SLOTS, Slot{nullptr, 0, 0, -1}),
+  used(0) {
+  std::fill(shorts, shorts + 256, -1);
+}
+
+OptionIndex::~OptionIndex() {
+
+}
+
+std::size_t OptionIndex::hashName(
+    const char* name_,
+    std::size_t length_) noexcept {
+  /* -- FNV-1a */
+  std::size_t hash_(2166136261u);
+  for(std::size_t i_(0); i_ < length_; ++i_) {
+    hash_ ^= static_cast<unsigned char>(name_[i_]);
+    hash_ *= 16777619u;
+  }
+  return hash_;
+}
+
+void OptionIndex::insertShort(
+    char short_,
+    int option_) {
+  assert(option_ >= 0);
+  shorts[static_cast<unsigned char>(short_)] = option_;
+}
+
+void OptionIndex::insertSlot(
+    const Slot& slot_) noexcept {
+  const std::size_t mask_(slots.size() - 1);
+  std::size_t pos_(slot_.hash & mask_);
+  while(slots[pos_].option >= 0)
+    pos_ = (pos_ + 1) & mask_;
+  slots[pos_] = slot_;
+}
+
+void OptionIndex::grow() {
+  std::vector<Slot> old_(slots.size() * 2, Slot{nullptr, 0, 0, -1});
+  old_.swap(slots);
+  for(const auto& slot_ : old_) {
+    if(slot_.option >= 0)
+      insertSlot(slot_);
+  }
+}
+
+void OptionIndex::insertLong(
+    const char* name_,
+    std::size_t length_,
+    int option_) {
+  assert(name_ != nullptr && option_ >= 0);
+
+  /* -- the table is kept at most half full */
+  if(2 * (used + 1) > slots.size())
+    grow();
+  insertSlot({name_, length_, hashName(name_, length_), option_});
+  ++used;
+}
+
+int OptionIndex::findShort(
+    char short_) const noexcept {
+  return shorts[static_cast<unsigned char>(short_)];
+}
+
+int OptionIndex::findLong(
+    const char* name_,
+    std::size_t length_) const noexcept {
+  const std::size_t hash_(hashName(name_, length_));
+  const std::size_t mask_(slots.size() - 1);
+  for(std::size_t pos_(hash_ & mask_);
+      slots[pos_].option >= 0;
+      pos_ = (pos_ + 1) & mask_) {
+    const Slot& slot_(slots[pos_]);
+    if(slot_.hash == hash_
+        && slot_.length == length_
+        && std::memcmp(slot_.name, name_, length_) == 0)
+      return slot_.option;
+  }
+  return -1;
+}
+
+} /* -- namespace Usage */
+
+} /* -- namespace OndraRT */
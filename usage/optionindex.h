@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__USAGE_OPTIONINDEX_H_
+#define OndraRT__USAGE_OPTIONINDEX_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace OndraRT {
+
+namespace Usage {
+
+/**
+ * @brief Index of command line options
+ *
+ * The index maps the short and long option names onto indexes of the
+ * options. The short options are looked up in a direct table, the long
+ * ones in an open addressing hash table. The lookups don't allocate
+ * memory, so the names can be looked up directly in the argv strings.
+ */
+class OptionIndex {
+  public:
+    /**
+     * @brief Ctor
+     */
+    OptionIndex();
+
+    /**
+     * @brief Dtor
+     */
+    ~OptionIndex();
+
+    /* -- avoid copying */
+    OptionIndex(
+        const OptionIndex&) = delete;
+    OptionIndex& operator =(
+        const OptionIndex&) = delete;
+
+    /**
+     * @brief Register a short option
+     *
+     * @param short_ The option character
+     * @param option_ Index of the option
+     */
+    void insertShort(
+        char short_,
+        int option_);
+
+    /**
+     * @brief Register a long option
+     *
+     * @param name_ Name of the option. The name is not copied, it must
+     *     be valid for whole life of the index.
+     * @param length_ Length of the name
+     * @param option_ Index of the option
+     */
+    void insertLong(
+        const char* name_,
+        std::size_t length_,
+        int option_);
+
+    /**
+     * @brief Find a short option
+     *
+     * @return Index of the option or -1 if it's not registered
+     */
+    int findShort(
+        char short_) const noexcept;
+
+    /**
+     * @brief Find a long option
+     *
+     * @param name_ Name of the option (it doesn't have to be terminated
+     *     by zero)
+     * @param length_ Length of the name
+     * @return Index of the option or -1 if it's not registered
+     */
+    int findLong(
+        const char* name_,
+        std::size_t length_) const noexcept;
+
+  private:
+    struct Slot {
+      const char* name;
+      std::size_t length;
+      std::size_t hash;
+      int option;
+    };
+
+    static std::size_t hashName(
+        const char* name_,
+        std::size_t length_) noexcept;
+    void insertSlot(
+        const Slot& slot_) noexcept;
+    void grow();
+
+    int shorts[256];
+    std::vector<Slot> slots;
+    std::size_t used;
+};
+
+} /* -- namespace Usage */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__USAGE_OPTIONINDEX_H_ */
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "responsefile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "usageerror.h"
+
+namespace OndraRT {
+
+namespace Usage {
+
+namespace {
+
+bool isSpace(
+    char c_) noexcept {
+  return c_ == ' ' || c_ == '\t' || c_ == '\n' || c_ == '\r'
+      || c_ == '\f' || c_ == '\v';
+}
+
+UsageError fileError(
+    const std::string& path_,
+    int error_) {
+  return UsageError(
+      "cannot read response file " + path_ + ": " + std::strerror(error_));
+}
+
+} /* -- namespace */
+
+ResponseFile::ResponseFile(
+    const char* path_) :
+  path(path_),
+  device(0),
+  inode(0),
+  mapping(nullptr),
+  mapping_size(0),
+  buffer(),
+  current(nullptr),
+  end(nullptr) {
+  int fd_(::open(path_, O_RDONLY | O_CLOEXEC));
+  if(fd_ < 0)
+    throw fileError(path, errno);
+
+  struct stat stat_;
+  if(::fstat(fd_, &stat_) != 0) {
+    const int error_(errno);
+    ::close(fd_);
+    throw fileError(path, error_);
+  }
+  device = stat_.st_dev;
+  inode = stat_.st_ino;
+
+  /* -- The size of pipes and of the /proc files is not known, they
+   *    cannot be mapped. */
+  if(!S_ISREG(stat_.st_mode) || stat_.st_size == 0) {
+    try {
+      readFile(fd_);
+    }
+    catch(...) {
+      ::close(fd_);
+      throw;
+    }
+    ::close(fd_);
+    return;
+  }
+  const std::size_t size_(stat_.st_size);
+
+  /* -- The last parameter needs a terminating zero behind the content
+   *    of the file. Hence an anonymous area one page longer than the file
+   *    is reserved and the file is mapped over its beginning. The rest
+   *    of the area is filled by zeros. */
+  const std::size_t page_(::sysconf(_SC_PAGESIZE));
+  mapping_size = (size_ / page_ + 1) * page_;
+  void* area_(::mmap(
+      nullptr,
+      mapping_size,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0));
+  if(area_ == MAP_FAILED) {
+    const int error_(errno);
+    ::close(fd_);
+    throw fileError(path, error_);
+  }
+  if(size_ > 0) {
+    void* file_area_(::mmap(
+        area_,
+        size_,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_FIXED,
+        fd_,
+        0));
+    if(file_area_ == MAP_FAILED) {
+      const int error_(errno);
+      ::munmap(area_, mapping_size);
+      ::close(fd_);
+      throw fileError(path, error_);
+    }
+    ::madvise(area_, size_, MADV_SEQUENTIAL);
+  }
+  ::close(fd_);
+
+  mapping = static_cast<char*>(area_);
+  current = mapping;
+  end = mapping + size_;
+}
+
+ResponseFile::~ResponseFile() {
+  if(mapping != nullptr)
+    ::munmap(mapping, mapping_size);
+}
+
+void ResponseFile::readFile(
+    int fd_) {
+  constexpr std::size_t CHUNK(4096);
+  std::size_t size_(0);
+  while(true) {
+    buffer.resize(size_ + CHUNK);
+    const ssize_t read_(::read(fd_, buffer.data() + size_, CHUNK));
+    if(read_ < 0) {
+      if(errno == EINTR)
+        continue;
+      throw fileError(path, errno);
+    }
+    if(read_ == 0)
+      break;
+    size_ += read_;
+  }
+
+  /* -- the last parameter is terminated behind the content */
+  buffer.resize(size_ + 1);
+  buffer[size_] = 0;
+  current = buffer.data();
+  end = current + size_;
+}
+
+bool ResponseFile::isSameFile(
+    const ResponseFile& other_) const noexcept {
+  return device == other_.device && inode == other_.inode;
+}
+
+const char* ResponseFile::nextParameter() {
+  while(current != end && isSpace(*current))
+    ++current;
+  if(current == end)
+    return nullptr;
+
+  /* -- The parameter is unquoted in place. The output position never
+   *    overtakes the input one. */
+  char* parameter_(current);
+  char* out_(current);
+  char quote_(0);
+  while(current != end) {
+    char c_(*current);
+    if(quote_ != 0) {
+      if(c_ == quote_) {
+        quote_ = 0;
+        ++current;
+        continue;
+      }
+      if(c_ == '\\' && quote_ == '"' && current + 1 != end)
+        c_ = *++current;
+    }
+    else {
+      if(isSpace(c_))
+        break;
+      if(c_ == '\'' || c_ == '"') {
+        quote_ = c_;
+        ++current;
+        continue;
+      }
+      if(c_ == '\\' && current + 1 != end)
+        c_ = *++current;
+    }
+    *out_++ = c_;
+    ++current;
+  }
+  if(quote_ != 0)
+    throw UsageError("unfinished quotation in response file " + path);
+
+  /* -- terminate the parameter (possibly over the separator or behind
+   *    the end of the file) */
+  if(current != end)
+    ++current;
+  *out_ = 0;
+
+  return parameter_;
+}
+
+} /* -- namespace Usage */
+
+} /* -- namespace OndraRT */
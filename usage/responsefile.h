@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OndraRT__USAGE_RESPONSEFILE_H_
+#define OndraRT__USAGE_RESPONSEFILE_H_
+
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace OndraRT {
+
+namespace Usage {
+
+/**
+ * @brief A response file (a file containing command line parameters)
+ *
+ * The file is mapped privately (copy-on-write) into the memory and it's
+ * tokenized in place: the quotes and the escaping backslashes are removed
+ * and the parameters are terminated by zero characters directly in the
+ * mapping. Hence the parameters stay valid as long as the object lives.
+ *
+ * Files whose size is not known in advance (pipes, FIFOs or files
+ * of the /proc filesystem) are read into a buffer instead.
+ *
+ * The parameters are separated by white spaces. A white space can be
+ * quoted by single or double quotes or escaped by a backslash. Inside
+ * the double quotes the backslash escapes next character too.
+ */
+class ResponseFile {
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param path_ Path of the file
+     * @exception UsageError if the file cannot be opened, read or mapped
+     */
+    explicit ResponseFile(
+        const char* path_);
+
+    /**
+     * @brief Dtor
+     */
+    ~ResponseFile();
+
+    /* -- avoid copying */
+    ResponseFile(
+        const ResponseFile&) = delete;
+    ResponseFile& operator =(
+        const ResponseFile&) = delete;
+
+    /**
+     * @brief Check whether the response file is the same file
+     *
+     * @param other_ The other response file
+     */
+    bool isSameFile(
+        const ResponseFile& other_) const noexcept;
+
+    /**
+     * @brief Get next parameter
+     *
+     * @return The parameter or nullptr at the end of the file
+     * @exception UsageError if a quotation is not finished
+     */
+    const char* nextParameter();
+
+  private:
+    void readFile(
+        int fd_);
+
+    std::string path;
+    dev_t device;
+    ino_t inode;
+    char* mapping;
+    std::size_t mapping_size;
+    std::vector<char> buffer;
+    char* current;
+    char* end;
+};
+
+} /* -- namespace Usage */
+
+} /* -- namespace OndraRT */
+
+#endif /* OndraRT__USAGE_RESPONSEFILE_H_ */
@@ -19,15 +19,24 @@
 
 #include "usage.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <tuple>
 #include <vector>
+#include <sys/ioctl.h>
+#include <unistd.h>
 
 #include "linedriver.h"
+#include "linedriverbuffered.h"
 #include "linedriverpre.h"
+#include "linedriverterm.h"
+#include "optionindex.h"
+#include "responsefile.h"
 #include "typograph.h"
 #include "typographblock.h"
 #include "typographblockattrs.h"
@@ -36,6 +45,7 @@
 #include "typographblockholder.h"
 #include "typographblockpar.h"
 #include "typographblocktext.h"
+#include "usageerror.h"
 
 namespace OndraRT {
 
@@ -46,6 +56,39 @@ namespace T = Typograph;
 namespace {
 
 constexpr const int INDENT_LEVEL(2);
+constexpr const int DEFAULT_WIDTH(80);
+constexpr const std::size_t MAX_RENDERED(64);
+
+/**
+ * @brief Detect width of the terminal
+ *
+ * The width is read from the terminal if the stream is the standard
+ * output or the standard error. Otherwise, the COLUMNS environment
+ * variable or the default width is used.
+ */
+int detectWidth(
+    std::ostream& os_) {
+  int fd_(-1);
+  if(&os_ == &std::cout)
+    fd_ = STDOUT_FILENO;
+  else if(&os_ == &std::cerr || &os_ == &std::clog)
+    fd_ = STDERR_FILENO;
+  if(fd_ >= 0) {
+    struct winsize size_;
+    if(::ioctl(fd_, TIOCGWINSZ, &size_) == 0 && size_.ws_col > 0)
+      return size_.ws_col;
+  }
+
+  const char* columns_(std::getenv("COLUMNS"));
+  if(columns_ != nullptr) {
+    char* end_;
+    long width_(std::strtol(columns_, &end_, 10));
+    if(end_ != columns_ && *end_ == 0 && width_ > 0 && width_ < 0x10000)
+      return width_;
+  }
+
+  return DEFAULT_WIDTH;
+}
 
 /**
  * @brief Usage context
@@ -53,7 +96,6 @@ constexpr const int INDENT_LEVEL(2);
 class UsageContext {
   public:
     explicit UsageContext(
-        int width_,
         int max_short_,
         int max_long_);
     ~UsageContext();
@@ -64,24 +106,16 @@ class UsageContext {
     UsageContext& operator =(
         const UsageContext&) = delete;
 
-    void incIndent();
-    void decIndent();
-    std::tuple<int, int, int> getOptionColumns() const;
-    int getIndent() const;
+    std::tuple<int, int> getOptionColumns() const;
 
   private:
-    int width;
-    int indent;
     int max_short;
     int max_long;
 };
 
 UsageContext::UsageContext(
-    int width_,
     int max_short_,
     int max_long_) :
-  width(width_),
-  indent(0),
   max_short(max_short_),
   max_long(max_long_) {
 
@@ -91,28 +125,8 @@ UsageContext::~UsageContext() {
 
 }
 
-void UsageContext::incIndent() {
-  width -= INDENT_LEVEL;
-  ++indent;
-}
-
-void UsageContext::decIndent() {
-  width += INDENT_LEVEL;
-  --indent;
-}
-
-std::tuple<int, int, int> UsageContext::getOptionColumns() const {
-  int inter_columns_(0);
-  if (max_short > 0)
-    ++inter_columns_;
-  if (max_long > 0)
-    ++inter_columns_;
-  return std::tuple<int, int, int>(
-      max_short, max_long, width - max_short - max_long - inter_columns_);
-}
-
-int UsageContext::getIndent() const {
-  return indent * INDENT_LEVEL;
+std::tuple<int, int> UsageContext::getOptionColumns() const {
+  return std::tuple<int, int>(max_short, max_long);
 }
 
 class UsageRecord {
@@ -165,19 +179,14 @@ T::TypographBlock* Section::printRecord(
     UsageContext& context_,
     T::TypographBlockHolder& holder_) const {
   /* -- create the formatting boxes */
-  auto* text_(holder_.createBlock<T::TypographBlockText>(title));
+  auto* text_(holder_.createText(title));
   auto* attrs_(holder_.createBlock<T::TypographBlockAttrs>(
       text_,
       T::LineDriver::FS_DEFAULT,
       T::LineDriver::FW_BOLD,
       T::LineDriver::C_DEFAULT,
       T::LineDriver::C_DEFAULT));
-  auto* box_(holder_.createBlock<T::TypographBlockBox>(attrs_, 0, 1, 0, 0));
-
-  /* -- change indentantion */
-  context_.incIndent();
-
-  return box_;
+  return holder_.createBlock<T::TypographBlockBox>(attrs_, 0, 1, 0, 0);
 }
 
 class Option : public UsageRecord {
@@ -193,7 +202,8 @@ class Option : public UsageRecord {
         const std::string& long_,
         PresenceArg arg_presence_,
         const std::string& arg_name_,
-        const std::string& help_);
+        const std::string& help_,
+        const ValueHandler& handler_);
     virtual ~Option();
 
     /* -- avoid copying */
@@ -206,6 +216,18 @@ class Option : public UsageRecord {
         UsageContext& context_,
         T::TypographBlockHolder& holder_) const override;
 
+    Presence getPresence() const noexcept;
+    char getShort() const noexcept;
+    const std::string& getLong() const noexcept;
+    bool hasArgument() const noexcept;
+    PresenceArg getArgPresence() const noexcept;
+    const ValueHandler& getHandler() const noexcept;
+
+    /**
+     * @brief Get name of the option shown in error messages
+     */
+    std::string getName() const;
+
   private:
     Presence presence;
     char short_opt;
@@ -214,6 +236,7 @@ class Option : public UsageRecord {
     PresenceArg arg_presence;
     std::string arg_name;
     std::string help;
+    ValueHandler handler;
 };
 
 Option::Option(
@@ -227,7 +250,8 @@ Option::Option(
   argument(false),
   arg_presence(),
   arg_name(),
-  help(help_) {
+  help(help_),
+  handler() {
 
 }
 
@@ -237,14 +261,16 @@ Option::Option(
     const std::string& long_,
     PresenceArg arg_presence_,
     const std::string& arg_name_,
-    const std::string& help_) :
+    const std::string& help_,
+    const ValueHandler& handler_) :
   presence(presence_),
   short_opt(short_),
   long_opt(long_),
   argument(true),
   arg_presence(arg_presence_),
   arg_name(arg_name_),
-  help(help_) {
+  help(help_),
+  handler(handler_) {
 
 }
 
@@ -252,6 +278,37 @@ Option::~Option() {
 
 }
 
+Presence Option::getPresence() const noexcept {
+  return presence;
+}
+
+char Option::getShort() const noexcept {
+  return short_opt;
+}
+
+const std::string& Option::getLong() const noexcept {
+  return long_opt;
+}
+
+bool Option::hasArgument() const noexcept {
+  return argument;
+}
+
+PresenceArg Option::getArgPresence() const noexcept {
+  return arg_presence;
+}
+
+const ValueHandler& Option::getHandler() const noexcept {
+  return handler;
+}
+
+std::string Option::getName() const {
+  if(!long_opt.empty())
+    return "--" + long_opt;
+  else
+    return std::string("-") + short_opt;
+}
+
 T::TypographBlock* Option::printRecord(
     UsageContext& context_,
     T::TypographBlockHolder& holder_) const {
@@ -260,13 +317,16 @@ T::TypographBlock* Option::printRecord(
 
   /* -- short argument */
   if (std::get<0>(col_widths_) > 0) {
-    std::ostringstream oss_;
+    std::string label_;
     if (short_opt != 0) {
-      oss_ << '-' << short_opt;
-      if (argument)
-        oss_ << ' ' << arg_name;
+      label_ += '-';
+      label_ += short_opt;
+      if (argument) {
+        label_ += ' ';
+        label_ += arg_name;
+      }
     }
-    auto* text_(holder_.createBlock<T::TypographBlockText>(oss_.str()));
+    auto* text_(holder_.createText(label_));
     auto* attrs_(holder_.createBlock<T::TypographBlockAttrs>(
         text_,
         T::LineDriver::FS_DEFAULT,
@@ -279,18 +339,22 @@ T::TypographBlock* Option::printRecord(
 
   /* -- long argument */
   if (std::get<1>(col_widths_) > 0) {
-    std::ostringstream oss_;
+    std::string label_;
     if (!long_opt.empty()) {
-      oss_ << "--" << long_opt;
+      label_ += "--";
+      label_ += long_opt;
       if (argument) {
-        oss_ << '=';
-        if (arg_presence == PresenceArg::OPTIONAL)
-          oss_ << '[' << arg_name << ']';
+        label_ += '=';
+        if (arg_presence == PresenceArg::OPTIONAL) {
+          label_ += '[';
+          label_ += arg_name;
+          label_ += ']';
+        }
         else
-          oss_ << arg_name;
+          label_ += arg_name;
       }
     }
-    auto* text_(holder_.createBlock<T::TypographBlockText>(oss_.str()));
+    auto* text_(holder_.createText(label_));
     auto* attrs_(holder_.createBlock<T::TypographBlockAttrs>(
         text_,
         T::LineDriver::FS_DEFAULT,
@@ -301,9 +365,10 @@ T::TypographBlock* Option::printRecord(
     cols_.push_back({box_, std::get<1>(col_widths_)});
   }
 
-  /* -- help text */
-  auto* help_(holder_.createBlock<T::TypographBlockText>(help));
-  cols_.push_back({help_, std::get<2>(col_widths_)});
+  /* -- help text: it takes rest of the line, hence the blocks
+   *    don't depend on the width of the output. */
+  auto* help_(holder_.createText(help));
+  cols_.push_back({help_, -1});
 
   return holder_.createBlock<T::TypographBlockCols>(
       cols_.data(), cols_.size());
@@ -336,7 +401,6 @@ CloseSection::~CloseSection() {
 T::TypographBlock* CloseSection::printRecord(
     UsageContext& context_,
     T::TypographBlockHolder& holder_) const {
-  context_.decIndent();
   return nullptr;
 }
 
@@ -356,6 +420,44 @@ struct Usage::Impl {
     typedef std::vector<std::unique_ptr<UsageRecord>> UsageRecords;
     UsageRecords usage;
 
+    /* -- Layout of the usage records (parallel to the records). The blocks
+     *    are created lazily when the record is printed for the first time.
+     *    They don't depend on the output width, they are just rewound
+     *    and printed again. All the blocks live in one arena-backed
+     *    holder which is reset when the layout is invalidated. */
+    struct RecordLayout {
+      int depth;
+      bool created;
+      T::TypographBlock* block;
+    };
+    std::vector<RecordLayout> layouts;
+    T::TypographBlockHolder holder;
+    int depth;
+    std::map<std::string, int> sections;
+
+    /* -- rendered output: (first record, end record, width, terminal) */
+    typedef std::tuple<int, int, int, bool> RenderedKey;
+    std::map<RenderedKey, std::string> rendered;
+
+    /* -- registered options and the parsed command line. The values point
+     *    into the argv array (nullptr means an omitted optional argument). */
+    struct Occurrences {
+      int count;
+      std::vector<const char*> values;
+    };
+    std::vector<const Option*> options;
+    std::vector<int> option_records;
+    OptionIndex index;
+    std::vector<Occurrences> occurrences;
+    std::vector<const char*> arguments;
+
+    /* -- Command line parameters being parsed: the argv array and the stack
+     *    of opened response files. The files are kept mapped because
+     *    the values point into them. */
+    int next_parameter;
+    std::vector<std::unique_ptr<ResponseFile>> response_files;
+    std::vector<ResponseFile*> response_stack;
+
     /* -- avoid copying */
     Impl(
         const Impl&) = delete;
@@ -369,6 +471,45 @@ struct Usage::Impl {
         const std::string& brief_,
         const std::string& extra_args_);
     ~Impl();
+
+    void invalidateLayout() noexcept;
+    void addRecord(
+        std::unique_ptr<UsageRecord>&& record_,
+        int depth_);
+    void openSection(
+        const std::string* name_,
+        const std::string& title_);
+    T::TypographBlock* getRecordBlock(
+        int record_);
+    void writeRecords(
+        T::LineDriver* driver_,
+        int width_,
+        int first_,
+        int end_);
+    void printRecords(
+        std::ostream& os_,
+        int width_,
+        bool terminal_,
+        int first_,
+        int end_);
+
+    void registerOption(
+        const Option* option_);
+    const Occurrences& findOccurrences(
+        char short_) const;
+    const Occurrences& findOccurrences(
+        const std::string& long_) const;
+    void addOccurrence(
+        int option_,
+        const char* value_);
+    void openResponseFile(
+        const char* path_);
+    const char* nextParameter();
+    void parseLong(
+        const char* arg_);
+    void parseShort(
+        const char* arg_);
+    void parseCommandLine();
 };
 
 Usage::Impl::Impl(
@@ -384,7 +525,19 @@ Usage::Impl::Impl(
   extra_args(extra_args_),
   max_short(0),
   max_long(0),
-  usage() {
+  usage(),
+  layouts(),
+  depth(0),
+  sections(),
+  rendered(),
+  options(),
+  option_records(),
+  index(),
+  occurrences(),
+  arguments(),
+  next_parameter(0),
+  response_files(),
+  response_stack() {
 
 }
 
@@ -392,6 +545,102 @@ Usage::Impl::~Impl() {
 
 }
 
+void Usage::Impl::invalidateLayout() noexcept {
+  for(auto& layout_ : layouts) {
+    layout_.created = false;
+    layout_.block = nullptr;
+  }
+  holder.reset();
+  rendered.clear();
+}
+
+void Usage::Impl::addRecord(
+    std::unique_ptr<UsageRecord>&& record_,
+    int depth_) {
+  invalidateLayout();
+  layouts.push_back({depth_, false, nullptr});
+  usage.push_back(std::move(record_));
+}
+
+void Usage::Impl::openSection(
+    const std::string* name_,
+    const std::string& title_) {
+  const int record_(usage.size());
+  addRecord(std::unique_ptr<UsageRecord>(new Section(title_)), depth);
+  if(name_ != nullptr)
+    sections.emplace(*name_, record_);
+  ++depth;
+}
+
+T::TypographBlock* Usage::Impl::getRecordBlock(
+    int record_) {
+  RecordLayout& layout_(layouts[record_]);
+  if(!layout_.created) {
+    UsageContext context_(max_short, max_long);
+    layout_.block = usage[record_]->printRecord(context_, holder);
+    layout_.created = true;
+  }
+  return layout_.block;
+}
+
+void Usage::Impl::writeRecords(
+    T::LineDriver* driver_,
+    int width_,
+    int first_,
+    int end_) {
+  T::Typograph typograph_(driver_, width_);
+  const int base_depth_(first_ < end_ ? layouts[first_].depth : 0);
+  for(int i_(first_); i_ < end_; ++i_) {
+    auto* block_(getRecordBlock(i_));
+    if(block_ != nullptr) {
+      /* -- the indentation is relative to the first printed record */
+      block_->reset();
+      T::TypographBlockBox box_(block_, 0);
+      box_.setPadding(
+          (layouts[i_].depth - base_depth_) * INDENT_LEVEL, 0, 0, 0);
+      typograph_.writeBlock(box_);
+    }
+  }
+}
+
+void Usage::Impl::printRecords(
+    std::ostream& os_,
+    int width_,
+    bool terminal_,
+    int first_,
+    int end_) {
+  /* -- The width is detected at every call, so the caller just prints
+   *    the usage again when the terminal is resized. */
+  if(width_ < 0)
+    width_ = detectWidth(os_);
+
+  const RenderedKey key_(first_, end_, width_, terminal_);
+  auto iter_(rendered.find(key_));
+  if(iter_ == rendered.end()) {
+    std::ostringstream oss_;
+    if(terminal_) {
+      OndraRT::Terminal::LineDriverTerm driver_(&oss_);
+      writeRecords(&driver_, width_, first_, end_);
+    }
+    else {
+      oss_ << "<html><body><pre>" << std::endl;
+      {
+        T::LineDriverPre driver_(&oss_);
+        T::LineDriverBuffered buffered_(&driver_);
+        writeRecords(&buffered_, width_, first_, end_);
+      }
+      oss_ << "</pre></body></html>" << std::endl;
+    }
+
+    /* -- the widths change by resizing of the terminal, don't keep
+     *    all of them */
+    if(rendered.size() >= MAX_RENDERED)
+      rendered.clear();
+    iter_ = rendered.emplace(key_, oss_.str()).first;
+  }
+  os_.write(iter_->second.data(), iter_->second.size());
+}
+
 Usage::Usage(
     int argc_,
     char* argv_[]) :
@@ -438,9 +687,213 @@ void Usage::setExtraArgs(
   pimpl->extra_args = extra_args_;
 }
 
+void Usage::Impl::registerOption(
+    const Option* option_) {
+  const char short_(option_->getShort());
+  const std::string& long_(option_->getLong());
+  if(short_ != 0 && index.findShort(short_) >= 0)
+    throw UsageError(std::string("duplicate option -") + short_);
+  if(!long_.empty() && index.findLong(long_.data(), long_.size()) >= 0)
+    throw UsageError("duplicate option --" + long_);
+
+  const int option_index_(options.size());
+  occurrences.push_back({0, {}});
+  options.push_back(option_);
+  option_records.push_back(usage.size());
+  if(short_ != 0)
+    index.insertShort(short_, option_index_);
+  if(!long_.empty())
+    index.insertLong(long_.data(), long_.size(), option_index_);
+}
+
+const Usage::Impl::Occurrences& Usage::Impl::findOccurrences(
+    char short_) const {
+  const int option_(index.findShort(short_));
+  if(short_ == 0 || option_ < 0)
+    throw UsageError(std::string("unknown option -") + short_);
+  return occurrences[option_];
+}
+
+const Usage::Impl::Occurrences& Usage::Impl::findOccurrences(
+    const std::string& long_) const {
+  const int option_(index.findLong(long_.data(), long_.size()));
+  if(long_.empty() || option_ < 0)
+    throw UsageError("unknown option --" + long_);
+  return occurrences[option_];
+}
+
+void Usage::Impl::addOccurrence(
+    int option_,
+    const char* value_) {
+  const Option* opt_(options[option_]);
+  Occurrences& occurrences_(occurrences[option_]);
+  if(opt_->hasArgument()) {
+    if(value_ != nullptr
+        && *value_ == 0
+        && opt_->getArgPresence() == PresenceArg::NOT_EMPTY)
+      throw UsageError(
+          "option " + opt_->getName() + " requires a non-empty argument");
+    if(opt_->getHandler() && !opt_->getHandler()(value_))
+      throw UsageError(
+          "invalid argument '" + std::string(value_ != nullptr ? value_ : "")
+          + "' of option " + opt_->getName());
+    occurrences_.values.push_back(value_);
+  }
+  ++occurrences_.count;
+}
+
+void Usage::Impl::openResponseFile(
+    const char* path_) {
+  std::unique_ptr<ResponseFile> file_(new ResponseFile(path_));
+  for(const auto* opened_ : response_stack) {
+    if(file_->isSameFile(*opened_))
+      throw UsageError(
+          std::string("recursive inclusion of response file ") + path_);
+  }
+  response_stack.push_back(file_.get());
+  response_files.push_back(std::move(file_));
+}
+
+const char* Usage::Impl::nextParameter() {
+  for(;;) {
+    const char* parameter_;
+    if(!response_stack.empty()) {
+      parameter_ = response_stack.back()->nextParameter();
+      if(parameter_ == nullptr) {
+        response_stack.pop_back();
+        continue;
+      }
+    }
+    else if(next_parameter < argc)
+      parameter_ = argv[next_parameter++];
+    else
+      return nullptr;
+
+    /* -- expand the response files */
+    if(parameter_[0] == '@' && parameter_[1] != 0)
+      openResponseFile(parameter_ + 1);
+    else
+      return parameter_;
+  }
+}
+
+void Usage::Impl::parseLong(
+    const char* arg_) {
+  const char* name_(arg_ + 2);
+  const char* value_(std::strchr(name_, '='));
+  const std::size_t length_(
+      value_ != nullptr ? value_ - name_ : std::strlen(name_));
+  if(value_ != nullptr)
+    ++value_;
+
+  const int option_(index.findLong(name_, length_));
+  if(option_ < 0)
+    throw UsageError("unknown option " + std::string(arg_, length_ + 2));
+  const Option* opt_(options[option_]);
+
+  if(!opt_->hasArgument()) {
+    if(value_ != nullptr)
+      throw UsageError(
+          "option " + opt_->getName() + " doesn't take an argument");
+  }
+  else if(value_ == nullptr
+      && opt_->getArgPresence() != PresenceArg::OPTIONAL) {
+    /* -- the argument is the next command line parameter */
+    value_ = nextParameter();
+    if(value_ == nullptr)
+      throw UsageError("option " + opt_->getName() + " requires an argument");
+  }
+  addOccurrence(option_, value_);
+}
+
+void Usage::Impl::parseShort(
+    const char* arg_) {
+  /* -- a group of short options: the first one taking an argument
+   *    consumes rest of the group. */
+  for(const char* curr_(arg_ + 1); *curr_ != 0; ++curr_) {
+    const int option_(index.findShort(*curr_));
+    if(option_ < 0)
+      throw UsageError(std::string("unknown option -") + *curr_);
+    const Option* opt_(options[option_]);
+
+    if(!opt_->hasArgument()) {
+      addOccurrence(option_, nullptr);
+      continue;
+    }
+
+    const char* value_(nullptr);
+    if(curr_[1] != 0)
+      value_ = curr_ + 1;
+    else if(opt_->getArgPresence() != PresenceArg::OPTIONAL) {
+      value_ = nextParameter();
+      if(value_ == nullptr)
+        throw UsageError(
+            "option " + opt_->getName() + " requires an argument");
+    }
+    addOccurrence(option_, value_);
+    break;
+  }
+}
+
+void Usage::Impl::parseCommandLine() {
+  for(auto& occurrences_ : occurrences) {
+    occurrences_.count = 0;
+    occurrences_.values.clear();
+  }
+  arguments.clear();
+  response_stack.clear();
+  response_files.clear();
+  next_parameter = 1;
+
+  /* -- The options and the arguments may be mixed. The "--" parameter
+   *    finishes the options, the "-" one is an argument. */
+  bool options_end_(false);
+  const char* arg_;
+  while((arg_ = nextParameter()) != nullptr) {
+    if(options_end_ || arg_[0] != '-' || arg_[1] == 0)
+      arguments.push_back(arg_);
+    else if(arg_[1] != '-')
+      parseShort(arg_);
+    else if(arg_[2] == 0)
+      options_end_ = true;
+    else
+      parseLong(arg_);
+  }
+
+  /* -- check presence of the options */
+  for(std::size_t i_(0); i_ < options.size(); ++i_) {
+    const Presence presence_(options[i_]->getPresence());
+    const int count_(occurrences[i_].count);
+    if(count_ < presence_.min) {
+      if(count_ == 0)
+        throw UsageError("missing option " + options[i_]->getName());
+      else
+        throw UsageError(
+            "option " + options[i_]->getName() + " is not repeated enough");
+    }
+    if(presence_.max >= 0 && count_ > presence_.max)
+      throw UsageError(
+          "option " + options[i_]->getName() + " is repeated too many times");
+  }
+}
+
 void Usage::openSection(
     const std::string& title_) {
-  pimpl->usage.emplace_back(new Section(title_));
+  /* -- The title is the name of the section unless it's already used.
+   *    The repeated titles are valid, only the first such section can
+   *    be printed by its title then. */
+  if(pimpl->sections.find(title_) != pimpl->sections.end())
+    pimpl->openSection(nullptr, title_);
+  else
+    pimpl->openSection(&title_, title_);
+}
+
+void Usage::openSection(
+    const std::string& name_,
+    const std::string& title_) {
+  if(pimpl->sections.find(name_) != pimpl->sections.end())
+    throw UsageError("duplicate section " + name_);
+  pimpl->openSection(&name_, title_);
 }
 
 void Usage::addOption(
@@ -448,6 +901,11 @@ void Usage::addOption(
     char short_,
     const std::string& long_,
     const std::string& help_) {
+  /* -- register the option. Nothing is changed if it's a duplicate. */
+  std::unique_ptr<Option> option_(
+      new Option(presence_, short_, long_, help_));
+  pimpl->registerOption(option_.get());
+
   /* -- maximal lengths of the options help descriptions */
   if (short_ != 0 && pimpl->max_short < 2) {
     pimpl->max_short = 2;  /* -- '-' + short char */
@@ -456,8 +914,8 @@ void Usage::addOption(
     pimpl->max_long = long_.length() + 2; /* -- '--' long */
   }
 
-  /* -- create the usage record */
-  pimpl->usage.emplace_back(new Option(presence_, short_, long_, help_));
+  /* -- store the usage record */
+  pimpl->addRecord(std::move(option_), pimpl->depth);
 }
 
 void Usage::addOptionArg(
@@ -467,6 +925,29 @@ void Usage::addOptionArg(
     PresenceArg arg_presence_,
     const std::string& arg_name_,
     const std::string& help_) {
+  addOptionArg(
+      presence_,
+      short_,
+      long_,
+      arg_presence_,
+      arg_name_,
+      help_,
+      ValueHandler());
+}
+
+void Usage::addOptionArg(
+    Presence presence_,
+    char short_,
+    const std::string& long_,
+    PresenceArg arg_presence_,
+    const std::string& arg_name_,
+    const std::string& help_,
+    const ValueHandler& handler_) {
+  /* -- register the option. Nothing is changed if it's a duplicate. */
+  std::unique_ptr<Option> option_(new Option(
+      presence_, short_, long_, arg_presence_, arg_name_, help_, handler_));
+  pimpl->registerOption(option_.get());
+
   /* -- maximal lengths of the options help descriptions */
   int name_len_(arg_name_.length());
   if (arg_presence_ == PresenceArg::OPTIONAL)
@@ -478,9 +959,8 @@ void Usage::addOptionArg(
     pimpl->max_long = long_.length() + 3 + name_len_; /* -- '--' long '=' name */
   }
 
-  /* -- create the usage record */
-  pimpl->usage.emplace_back(new Option(
-      presence_, short_, long_, arg_presence_, arg_name_, help_));
+  /* -- store the usage record */
+  pimpl->addRecord(std::move(option_), pimpl->depth);
 }
 
 void Usage::addText(
@@ -495,42 +975,116 @@ void Usage::addExplanation(
 }
 
 void Usage::closeSection() {
-  pimpl->usage.emplace_back(new CloseSection());
+  if(pimpl->depth > 0)
+    --pimpl->depth;
+  pimpl->addRecord(
+      std::unique_ptr<UsageRecord>(new CloseSection()), pimpl->depth);
+}
+
+void Usage::parseCommandLine() {
+  pimpl->parseCommandLine();
+}
+
+int Usage::getOptionCount(
+    char short_) const {
+  return pimpl->findOccurrences(short_).count;
+}
+
+int Usage::getOptionCount(
+    const std::string& long_) const {
+  return pimpl->findOccurrences(long_).count;
+}
+
+const char* Usage::getOptionValue(
+    char short_,
+    int occurrence_) const {
+  const auto& values_(pimpl->findOccurrences(short_).values);
+  if(occurrence_ < 0
+      || static_cast<std::size_t>(occurrence_) >= values_.size()) {
+    return nullptr;
+  }
+  return values_[occurrence_];
+}
+
+const char* Usage::getOptionValue(
+    const std::string& long_,
+    int occurrence_) const {
+  const auto& values_(pimpl->findOccurrences(long_).values);
+  if(occurrence_ < 0
+      || static_cast<std::size_t>(occurrence_) >= values_.size()) {
+    return nullptr;
+  }
+  return values_[occurrence_];
+}
+
+int Usage::getArgumentCount() const {
+  return pimpl->arguments.size();
+}
+
+const char* Usage::getArgument(
+    int index_) const {
+  if(index_ < 0
+      || static_cast<std::size_t>(index_) >= pimpl->arguments.size()) {
+    return nullptr;
+  }
+  return pimpl->arguments[index_];
 }
 
 void Usage::printUsage() {
-  printUsage(std::cout, -1, false);
+  printUsage(std::cout, -1, ::isatty(STDOUT_FILENO));
 }
 
 void Usage::printUsage(
     std::ostream& os_,
     int width_,
     bool terminal_) {
-  /* -- TODO: detect width of the terminal */
-  if(width_ < 0)
-    width_ = 80;
-
-  /* -- construct the typograph */
-  os_ << "<html><body><pre>" << std::endl;
-  T::LineDriverPre driver_(&os_);
-  T::Typograph typograph_(&driver_, width_);
-
-  /* -- print usage */
-  UsageContext context_(width_, pimpl->max_short, pimpl->max_long);
-  for(const auto& record_ : pimpl->usage) {
-    T::TypographBlockHolder holder_;
-
-    /* -- get left padding for indentation before the record changes
-     *    the context. */
-    int left_padding_(context_.getIndent());
-    auto* block_(record_->printRecord(context_, holder_));
-    if(block_ != nullptr) {
-      T::TypographBlockBox box_(block_, 0);
-      box_.setPadding(left_padding_, 0, 0, 0);
-      typograph_.writeBlock(box_);
-    }
-  }
-  os_ << "</pre></body></html>" << std::endl;
+  pimpl->printRecords(os_, width_, terminal_, 0, pimpl->usage.size());
+}
+
+void Usage::printSection(
+    std::ostream& os_,
+    const std::string& name_,
+    int width_,
+    bool terminal_) {
+  auto iter_(pimpl->sections.find(name_));
+  if(iter_ == pimpl->sections.end())
+    throw UsageError("unknown section " + name_);
+
+  /* -- find end of the section */
+  const int first_(iter_->second);
+  const int depth_(pimpl->layouts[first_].depth);
+  const int count_(pimpl->usage.size());
+  int end_(first_ + 1);
+  while(end_ < count_ && pimpl->layouts[end_].depth > depth_)
+    ++end_;
+  if(end_ < count_)
+    ++end_; /* -- the closing record */
+
+  pimpl->printRecords(os_, width_, terminal_, first_, end_);
+}
+
+void Usage::printOption(
+    std::ostream& os_,
+    char short_,
+    int width_,
+    bool terminal_) {
+  const int option_(pimpl->index.findShort(short_));
+  if(short_ == 0 || option_ < 0)
+    throw UsageError(std::string("unknown option -") + short_);
+  const int record_(pimpl->option_records[option_]);
+  pimpl->printRecords(os_, width_, terminal_, record_, record_ + 1);
+}
+
+void Usage::printOption(
+    std::ostream& os_,
+    const std::string& long_,
+    int width_,
+    bool terminal_) {
+  const int option_(pimpl->index.findLong(long_.data(), long_.size()));
+  if(long_.empty() || option_ < 0)
+    throw UsageError("unknown option --" + long_);
+  const int record_(pimpl->option_records[option_]);
+  pimpl->printRecords(os_, width_, terminal_, record_, record_ + 1);
 }
 
 } /* -- namespace Getopt */
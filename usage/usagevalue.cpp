@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2019 Ondrej Starek
+ *
+ * This file is part of OndraRT.
+ *
+ * OndraRT is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OndraRT is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OndraRT.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "usagevalue.h"
+
+#include <cerrno>
+#include <cstdlib>
+
+namespace OndraRT {
+
+namespace Usage {
+
+namespace {
+
+/* -- the number must start by a digit (after an optional sign), so
+ *    the white spaces, "inf" or "nan" are not accepted. */
+bool isNumber(
+    const char* begin_,
+    const char* end_,
+    bool sign_) noexcept {
+  if(sign_ && begin_ != end_ && (*begin_ == '-' || *begin_ == '+'))
+    ++begin_;
+  if(begin_ != end_ && *begin_ == '.')
+    ++begin_;
+  return begin_ != end_ && *begin_ >= '0' && *begin_ <= '9';
+}
+
+bool isEqual(
+    const char* begin_,
+    const char* end_,
+    const char* word_) noexcept {
+  const std::size_t length_(std::strlen(word_));
+  return static_cast<std::size_t>(end_ - begin_) == length_
+      && std::strncmp(begin_, word_, length_) == 0;
+}
+
+char toLower(
+    char c_) noexcept {
+  if(c_ >= 'A' && c_ <= 'Z')
+    return c_ - 'A' + 'a';
+  return c_;
+}
+
+} /* -- namespace */
+
+bool parseSigned(
+    const char* begin_,
+    const char* end_,
+    long long& value_) {
+  if(!isNumber(begin_, end_, true))
+    return false;
+  char* stop_;
+  errno = 0;
+  const long long tmp_(std::strtoll(begin_, &stop_, 10));
+  if(stop_ != end_ || errno == ERANGE)
+    return false;
+  value_ = tmp_;
+  return true;
+}
+
+bool parseUnsigned(
+    const char* begin_,
+    const char* end_,
+    unsigned long long& value_) {
+  if(!isNumber(begin_, end_, false))
+    return false;
+  char* stop_;
+  errno = 0;
+  const unsigned long long tmp_(std::strtoull(begin_, &stop_, 10));
+  if(stop_ != end_ || errno == ERANGE)
+    return false;
+  value_ = tmp_;
+  return true;
+}
+
+bool parseFloating(
+    const char* begin_,
+    const char* end_,
+    long double& value_) {
+  if(!isNumber(begin_, end_, true))
+    return false;
+  char* stop_;
+  errno = 0;
+  const long double tmp_(std::strtold(begin_, &stop_));
+  if(stop_ != end_ || errno == ERANGE)
+    return false;
+  value_ = tmp_;
+  return true;
+}
+
+bool parseDuration(
+    const char* begin_,
+    const char* end_,
+    long double& value_,
+    bool& suffix_) {
+  if(!isNumber(begin_, end_, true))
+    return false;
+  char* stop_;
+  errno = 0;
+  long double tmp_(std::strtold(begin_, &stop_));
+  if(stop_ > end_ || errno == ERANGE)
+    return false;
+
+  static const struct {
+    const char* suffix;
+    long double seconds;
+  } UNITS[] = {
+      {"ns", 1e-9L},
+      {"us", 1e-6L},
+      {"ms", 1e-3L},
+      {"s", 1.0L},
+      {"m", 60.0L},
+      {"min", 60.0L},
+      {"h", 3600.0L},
+      {"d", 86400.0L},
+  };
+
+  suffix_ = (stop_ != end_);
+  if(suffix_) {
+    bool found_(false);
+    for(const auto& unit_ : UNITS) {
+      if(isEqual(stop_, end_, unit_.suffix)) {
+        tmp_ *= unit_.seconds;
+        found_ = true;
+        break;
+      }
+    }
+    if(!found_)
+      return false;
+  }
+  value_ = tmp_;
+  return true;
+}
+
+bool parseValue(
+    const char* begin_,
+    const char* end_,
+    bool& value_) {
+  static const char* const TRUE_WORDS[] = {"true", "yes", "on", "1"};
+  static const char* const FALSE_WORDS[] = {"false", "no", "off", "0"};
+  for(const char* word_ : TRUE_WORDS) {
+    if(isEqual(begin_, end_, word_)) {
+      value_ = true;
+      return true;
+    }
+  }
+  for(const char* word_ : FALSE_WORDS) {
+    if(isEqual(begin_, end_, word_)) {
+      value_ = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parseValue(
+    const char* begin_,
+    const char* end_,
+    ByteSize& value_) {
+  if(!isNumber(begin_, end_, false))
+    return false;
+  char* stop_;
+  errno = 0;
+  std::uint64_t bytes_(std::strtoull(begin_, &stop_, 10));
+  if(stop_ > end_ || errno == ERANGE)
+    return false;
+
+  /* -- binary multiplier suffix (K, KB, KiB...) */
+  const char* suffix_(stop_);
+  if(suffix_ != end_) {
+    static const char MULTIPLIERS[] = "kmgtpe";
+    const char* multiplier_(std::strchr(MULTIPLIERS, toLower(*suffix_)));
+    if(multiplier_ != nullptr && *multiplier_ != 0) {
+      const int shift_(10 * (multiplier_ - MULTIPLIERS + 1));
+      if(bytes_ > (std::numeric_limits<std::uint64_t>::max() >> shift_))
+        return false;
+      bytes_ <<= shift_;
+      ++suffix_;
+      if(end_ - suffix_ == 2 && suffix_[0] == 'i')
+        ++suffix_;
+    }
+    if(suffix_ != end_ && (*suffix_ == 'B' || *suffix_ == 'b'))
+      ++suffix_;
+    if(suffix_ != end_)
+      return false;
+  }
+
+  value_.bytes = bytes_;
+  return true;
+}
+
+bool parseValue(
+    const char* begin_,
+    const char* end_,
+    std::string& value_) {
+  value_.assign(begin_, end_);
+  return true;
+}
+
+ValueHandler bindValue(
+    const char** target_) {
+  return [target_](const char* value_) -> bool {
+    if(value_ != nullptr)
+      *target_ = value_;
+    return true;
+  };
+}
+
+} /* -- namespace Usage */
+
+} /* -- namespace OndraRT */